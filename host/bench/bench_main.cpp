@@ -0,0 +1,474 @@
+//##########################################################################
+//#
+//#		Benchmark of the loop hot path
+//#
+//#	Measures the functions that are called in each pass of 'loop()'
+//#		-	GetIOState()
+//#		-	CheckIOState()
+//#		-	CheckLnState()
+//#		-	DebounceClass::Work()
+//#	with the patterns
+//#		idle	the state does not change
+//#		one		one pin toggles
+//#		all		all 16 pins toggle
+//#
+//#	Usage:
+//#		fremo_uni_io_bench [--calls <n>] [--rounds <n>]
+//#
+//#	Output, one JSON object per line:
+//#		{"target":"host","version":10502,"bench":"CheckIOState",
+//#		 "pattern":"one","calls":20000,"ns_per_call":..,
+//#		 "ns_min":..,"ns_max":..}
+//#	'ns_per_call' is the median of all rounds, 'ns_min' and 'ns_max'
+//#	are the fastest and the slowest round.
+//#
+//#	Work that is not part of the measured function (changing the
+//#	pin levels, sending the queued Loconet messages) is done outside
+//#	of the time measurement.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the debouncer works on all 16 universal pins at once
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+
+#include <Arduino.h>
+
+#include "sim.h"
+
+#include "debounce.h"
+#include "io_control.h"
+#include "lncv_storage.h"
+#include "my_loconet.h"
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+#define DEFAULT_CALLS			20000
+#define DEFAULT_ROUNDS			5
+#define MAX_ROUNDS				32
+#define BATCH_SIZE				1000
+
+//----------------------------------------------------------------------
+//	the debouncer needs 4 equal samples to change the key state
+//
+#define DEBOUNCE_SAMPLES		4
+
+
+typedef void (*bench_func_t)( uint32_t ulCall );
+
+
+typedef struct bench_case
+{
+	const char *	pchBench;
+	const char *	pchPattern;
+	bench_func_t	pPrepare;		//	called before each batch (not measured)
+	bench_func_t	pRun;			//	measured function
+	uint32_t		ulBatch;		//	calls per measurement
+
+}	bench_case_t;
+
+
+//==========================================================================
+//
+//		F U N C T I O N   D E C L A R A T I O N
+//
+//==========================================================================
+
+//----	firmware  ------------------------------------------------------
+extern uint16_t	g_uiLnState;
+extern uint16_t	g_uiIOState;
+
+void		setup( void );
+uint16_t	GetIOState( void );
+void		CheckIOState( uint16_t uiNewIOState );
+void		CheckLnState( uint16_t uiNewLnState );
+
+
+//==========================================================================
+//
+//		G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+static uint32_t			g_ulCalls		= DEFAULT_CALLS;
+static uint32_t			g_ulRounds		= DEFAULT_ROUNDS;
+static uint16_t			g_uiVersion		= 0;
+static uint64_t			g_ullOverhead	= 0;
+
+static uint16_t			g_uiBase		= 0;
+static uint16_t			g_uiToggle		= 0;
+static uint16_t			g_uiPinLevel	= 0;
+static DebounceClass< uint16_t >	g_clDebounce( 0x0000 );
+
+volatile uint16_t		g_uiSink;
+
+
+//==========================================================================
+//
+//		F U N C T I O N S
+//
+//==========================================================================
+
+//**************************************************************************
+//	NowNs
+//--------------------------------------------------------------------------
+//
+static inline uint64_t NowNs( void )
+{
+	struct timespec	ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+
+	return( ((uint64_t)ts.tv_sec * 1000000000ULL) + ts.tv_nsec );
+}
+
+
+//**************************************************************************
+//	PatternState
+//--------------------------------------------------------------------------
+//	base state for even calls, toggled state for odd calls
+//
+static inline uint16_t PatternState( uint32_t ulCall )
+{
+	return( (ulCall & 1) ? (g_uiBase ^ g_uiToggle) : g_uiBase );
+}
+
+
+//**************************************************************************
+//	DrainSendQueue
+//--------------------------------------------------------------------------
+//	lets the virtual time run until all queued messages are sent
+//
+static void DrainSendQueue( void )
+{
+	while( 0 < g_clMyLoconet.GetSendQueueCount() )
+	{
+		SimAdvance( 1000 );
+		g_clMyLoconet.ProcessSendQueue();
+	}
+}
+
+
+//**************************************************************************
+//	ConfigureBoard
+//--------------------------------------------------------------------------
+//	all 16 pins as inputs or all 16 pins as outputs,
+//	each one with its own sensor address and without off delay
+//
+static void ConfigureBoard( bool bInputs )
+{
+	uint16_t	uiAddress	= bInputs ? 100 : 300;
+	uint16_t	uiMode		= bInputs ? 7 : 3;
+
+	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
+	{
+		g_clLncvStorage.WriteLNCV(	LNCV_ADR_FIRST_IO_ADDRESS + idx,
+									((uiAddress + idx) * 10) + uiMode	);
+		g_clLncvStorage.WriteLNCV( LNCV_ADR_FIRST_DELAY_ADDRESS + idx, 0 );
+
+		SimSetIOPin( idx, true );
+	}
+
+	g_clLncvStorage.Init();
+	g_clControl.Init( g_clLncvStorage.GetAsOutputs() );
+
+	g_uiPinLevel = 0xFFFF;
+
+	for( uint8_t idx = 0 ; idx < DEBOUNCE_SAMPLES ; idx++ )
+	{
+		g_clControl.SampleInputs();
+	}
+
+	CheckIOState( GetIOState() );
+	CheckLnState( 0x0000 );
+	DrainSendQueue();
+}
+
+
+//**************************************************************************
+//	prepare and run functions of the benchmarks
+//--------------------------------------------------------------------------
+//
+static void PrepareTogglePins( uint32_t )
+{
+	uint16_t	uiMask = 0x0001;
+
+	g_uiPinLevel ^= g_uiToggle;
+
+	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
+	{
+		if( g_uiToggle & uiMask )
+		{
+			SimSetIOPin( idx, 0 != (g_uiPinLevel & uiMask) );
+		}
+
+		uiMask <<= 1;
+	}
+
+	for( uint8_t idx = 0 ; idx < DEBOUNCE_SAMPLES ; idx++ )
+	{
+		g_clControl.SampleInputs();
+	}
+}
+
+
+static void PrepareDrain( uint32_t )
+{
+	DrainSendQueue();
+}
+
+
+static void RunGetIOState( uint32_t )
+{
+	g_uiSink = GetIOState();
+}
+
+
+static void RunCheckIOState( uint32_t ulCall )
+{
+	CheckIOState( PatternState( ulCall ) );
+}
+
+
+static void RunCheckLnState( uint32_t ulCall )
+{
+	CheckLnState( PatternState( ulCall ) );
+}
+
+
+static void RunDebounceWork( uint32_t ulCall )
+{
+	g_clDebounce.Work( PatternState( ulCall ) );
+}
+
+
+//**************************************************************************
+//	MeasureOverhead
+//--------------------------------------------------------------------------
+//	time needed by the time measurement itself
+//
+static void MeasureOverhead( void )
+{
+	uint64_t	ullStart;
+	uint64_t	ullTime;
+
+	g_ullOverhead = UINT64_MAX;
+
+	for( uint32_t idx = 0 ; idx < 10000 ; idx++ )
+	{
+		ullStart	= NowNs();
+		ullTime		= NowNs() - ullStart;
+
+		if( ullTime < g_ullOverhead )
+		{
+			g_ullOverhead = ullTime;
+		}
+	}
+}
+
+
+//**************************************************************************
+//	Measure
+//--------------------------------------------------------------------------
+//	runs one benchmark case and prints the result line
+//
+static void Measure( const bench_case_t *pCase )
+{
+	double		ardRound[ MAX_ROUNDS ];
+	uint64_t	ullStart;
+	uint64_t	ullTime;
+	uint64_t	ullTotal;
+	uint32_t	ulCall;
+
+	for( uint32_t ulRound = 0 ; ulRound < g_ulRounds ; ulRound++ )
+	{
+		ullTotal	= 0;
+		ulCall		= 0;
+
+		while( ulCall < g_ulCalls )
+		{
+			if( NULL != pCase->pPrepare )
+			{
+				pCase->pPrepare( ulCall );
+			}
+
+			ullStart = NowNs();
+
+			for( uint32_t idx = 0 ; idx < pCase->ulBatch ; idx++ )
+			{
+				pCase->pRun( ulCall + idx );
+			}
+
+			ullTime = NowNs() - ullStart;
+
+			ullTotal	+= (ullTime > g_ullOverhead) ? (ullTime - g_ullOverhead) : 0;
+			ulCall		+= pCase->ulBatch;
+		}
+
+		ardRound[ ulRound ] = (double)ullTotal / ulCall;
+	}
+
+	std::sort( ardRound, ardRound + g_ulRounds );
+
+	printf(	"{\"target\":\"host\",\"version\":%u,\"bench\":\"%s\",\"pattern\":\"%s\","
+			"\"calls\":%u,\"ns_per_call\":%.2f,\"ns_min\":%.2f,\"ns_max\":%.2f}\n",
+			g_uiVersion, pCase->pchBench, pCase->pchPattern, g_ulCalls,
+			ardRound[ g_ulRounds / 2 ], ardRound[ 0 ], ardRound[ g_ulRounds - 1 ]	);
+	fflush( stdout );
+}
+
+
+//**************************************************************************
+//	RunCase
+//--------------------------------------------------------------------------
+//
+static void RunCase(	const char *pchBench, bench_func_t pPrepare, bench_func_t pRun,
+						uint32_t ulBatch, uint16_t uiBase, uint16_t uiToggle			)
+{
+	bench_case_t	benchCase;
+
+	benchCase.pchBench		= pchBench;
+	benchCase.pPrepare		= pPrepare;
+	benchCase.pRun			= pRun;
+	benchCase.ulBatch		= ulBatch;
+
+	if( 0x0000 == uiToggle )
+	{
+		benchCase.pchPattern = "idle";
+	}
+	else if( 0x0000 == (uiToggle & (uiToggle - 1)) )
+	{
+		benchCase.pchPattern = "one";
+	}
+	else
+	{
+		benchCase.pchPattern = "all";
+	}
+
+	g_uiBase	= uiBase;
+	g_uiToggle	= uiToggle;
+
+	Measure( &benchCase );
+
+	//----------------------------------------------------------------
+	//	back to the base state for the next case
+	//
+	DrainSendQueue();
+
+	if( RunCheckIOState == pRun )
+	{
+		CheckIOState( uiBase );
+	}
+	else if( RunCheckLnState == pRun )
+	{
+		CheckLnState( uiBase );
+	}
+
+	DrainSendQueue();
+}
+
+
+//**************************************************************************
+//	main
+//--------------------------------------------------------------------------
+//
+int main( int argc, char *argv[] )
+{
+	char	chTempName[] = "/tmp/fremo_uni_io_bench_XXXXXX";
+	int		iFile;
+
+	for( int idx = 1 ; idx < argc ; idx++ )
+	{
+		if( (0 == strcmp( argv[ idx ], "--calls" )) && ((idx + 1) < argc) )
+		{
+			g_ulCalls = strtoul( argv[ ++idx ], NULL, 10 );
+		}
+		else if( (0 == strcmp( argv[ idx ], "--rounds" )) && ((idx + 1) < argc) )
+		{
+			g_ulRounds = strtoul( argv[ ++idx ], NULL, 10 );
+		}
+		else
+		{
+			fprintf( stderr, "usage: %s [--calls <n>] [--rounds <n>]\n", argv[ 0 ] );
+			return( 1 );
+		}
+	}
+
+	g_ulCalls	= std::max<uint32_t>( g_ulCalls, BATCH_SIZE );
+	g_ulCalls	= (g_ulCalls / BATCH_SIZE) * BATCH_SIZE;
+	g_ulRounds	= std::min<uint32_t>( std::max<uint32_t>( g_ulRounds, 1 ), MAX_ROUNDS );
+
+	iFile = mkstemp( chTempName );
+
+	if( (0 > iFile) || !SimEepromOpen( chTempName ) )
+	{
+		fprintf( stderr, "can't open EEPROM file '%s'\n", chTempName );
+		return( 1 );
+	}
+
+	close( iFile );
+
+	SimSetLogFile( NULL );
+	SimBusSetEcho( false );
+
+	setup();
+
+	g_uiVersion = g_clLncvStorage.ReadLNCV( LNCV_ADR_VERSION_NUMBER );
+
+	MeasureOverhead();
+
+	//----	all pins as inputs  ------------------------------------------
+	ConfigureBoard( true );
+
+	RunCase( "GetIOState",	 NULL,				RunGetIOState,	 BATCH_SIZE, 0x0000,		0x0000 );
+	RunCase( "GetIOState",	 PrepareTogglePins,	RunGetIOState,	 BATCH_SIZE, 0x0000,		0x0001 );
+	RunCase( "GetIOState",	 PrepareTogglePins,	RunGetIOState,	 BATCH_SIZE, 0x0000,		0xFFFF );
+
+	RunCase( "CheckIOState", NULL,				RunCheckIOState, BATCH_SIZE, g_uiIOState,	0x0000 );
+	RunCase( "CheckIOState", PrepareDrain,		RunCheckIOState, 1,			 g_uiIOState,	0x0001 );
+	RunCase( "CheckIOState", PrepareDrain,		RunCheckIOState, 1,			 g_uiIOState,	0xFFFF );
+
+	RunCase( "DebounceWork", NULL,				RunDebounceWork, BATCH_SIZE, 0xFFFF,		0x0000 );
+	RunCase( "DebounceWork", NULL,				RunDebounceWork, BATCH_SIZE, 0xFFFF,		0x0001 );
+	RunCase( "DebounceWork", NULL,				RunDebounceWork, BATCH_SIZE, 0xFFFF,		0xFFFF );
+
+	//----	all pins as outputs  -----------------------------------------
+	ConfigureBoard( false );
+
+	RunCase( "CheckLnState", NULL,				RunCheckLnState, BATCH_SIZE, g_uiLnState,	0x0000 );
+	RunCase( "CheckLnState", NULL,				RunCheckLnState, BATCH_SIZE, g_uiLnState,	0x0001 );
+	RunCase( "CheckLnState", NULL,				RunCheckLnState, BATCH_SIZE, g_uiLnState,	0xFFFF );
+
+	unlink( chTempName );
+
+	return( 0 );
+}
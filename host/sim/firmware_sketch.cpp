@@ -0,0 +1,35 @@
+//##########################################################################
+//#
+//#		Firmware sketch for the host build
+//#
+//#	The Arduino IDE compiles the .ino file as C++ after including
+//#	Arduino.h. This file does the same for the host build, so the
+//#	sketch is compiled unchanged.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the firmware no longer resets itself at the end of the
+//#			programming mode, so the reset vector is not needed
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <Arduino.h>
+
+#include "fremo_uni_io.ino"
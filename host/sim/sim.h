@@ -0,0 +1,143 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		Simulation
+//#
+//#	Interface of the simulated Arduino/AVR/LocoNet layer that is used
+//#	by the scenario runner (sim_main.cpp) and the benchmarks.
+//#
+//#	All time is virtual:
+//#		-	the clock only advances by SimAdvance(), delay() or
+//#			a blocking LocoNet send
+//#		-	every full millisecond the registered tick hooks are called,
+//#			so scripted events and simulated interrupts happen at the
+//#			right moment even while the firmware sits in a delay()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	4		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the reset vector is not simulated any more
+//#			removed function
+//#				SimReset()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	3		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the USB serial interface writes into a file
+//#			new function
+//#				SimSerialOpen()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	access to the pins by universal pin numbering
+//#			new functions
+//#				SimSetIOPin()
+//#				SimGetIOPin()
+//#				SimIsIOOutput()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <LocoNet.h>
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+//----------------------------------------------------------------------
+//	port numbers for SimSetPin()
+//
+#define SIM_PORT_B			0
+#define SIM_PORT_C			1
+#define SIM_PORT_D			2
+#define SIM_PORT_E			3
+#define SIM_PORT_F			4
+#define SIM_PORT_COUNT		5
+
+#define SIM_IO_NUMBERS		16
+
+//----------------------------------------------------------------------
+//	time needed to send one message on the LocoNet
+//	(4 bytes at 16.66 kBit/s plus carrier detect backoff)
+//
+#define SIM_LN_SEND_TIME_US		3600
+
+#define SIM_MAX_TICK_HOOKS		4
+
+//----------------------------------------------------------------------
+//	the host reads one USB bulk endpoint (64 bytes) per frame (1 ms)
+//
+#define SIM_USB_ENDPOINT_SIZE	64
+
+
+typedef void (*sim_tick_hook_t)( uint32_t ulMillis );
+
+
+//==========================================================================
+//
+//		F U N C T I O N   D E C L A R A T I O N
+//
+//==========================================================================
+
+//----	virtual clock  -------------------------------------------------
+void		SimSetClock( uint64_t ullMicros );
+uint64_t	SimGetClock( void );
+void		SimAdvance( uint32_t ulMicros );
+bool		SimAddTickHook( sim_tick_hook_t pHook );
+
+//----	port pins  -----------------------------------------------------
+void		SimSetPin( uint8_t usPort, uint8_t usBit, bool bHigh );
+bool		SimGetPortPin( uint8_t usPort, uint8_t usBit );
+bool		SimIsOutput( uint8_t usPort, uint8_t usBit );
+void		SimUpdatePins( void );
+
+void		SimSetIOPin( uint8_t usIOPin, bool bHigh );
+bool		SimGetIOPin( uint8_t usIOPin );
+bool		SimIsIOOutput( uint8_t usIOPin );
+
+//----	EEPROM  --------------------------------------------------------
+bool		SimEepromOpen( const char *pchFileName );
+
+//----	USB serial interface  ------------------------------------------
+void		SimSerialOpen( FILE *pFile );
+
+//----	LocoNet bus  ---------------------------------------------------
+void		SimBusInject( const lnMsg *pMsg );
+uint32_t	SimBusGetSendCount( void );
+void		SimBusSetEcho( bool bEcho );
+void		SimBusEncodeSensor( lnMsg *pMsg, uint16_t uiAddress, uint8_t usState );
+void		SimBusEncodeSwitch( lnMsg *pMsg, uint8_t usOpCode, uint16_t uiAddress,
+								uint8_t usOutput, uint8_t usDirection );
+void		SimBusEncodeLncv( lnMsg *pMsg, uint8_t usCommand, uint16_t uiArticle,
+							  uint16_t uiAddress, uint16_t uiValue );
+
+//----	output  --------------------------------------------------------
+void		SimSetLogFile( FILE *pFile );
+void		SimLog( const char *pchFormat, ... ) __attribute__(( format( printf, 1, 2 ) ));
@@ -0,0 +1,845 @@
+//##########################################################################
+//#
+//#		Simulation of the Arduino core and the AVR peripherals
+//#
+//#	-	virtual clock for millis(), micros() and delay()
+//#	-	port registers with pull-ups and externally driven levels
+//#	-	file backed EEPROM
+//#	-	timer interrupts on the virtual clock
+//#	-	USB serial interface
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	9		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	SimReset() removed, the firmware does not reset itself
+//#			any more
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	8		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	USB serial interface 'Serial', the data is written into
+//#			a file, SIM_USB_ENDPOINT_SIZE bytes per frame (1 ms)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	7		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	Timer 3 counts on the virtual clock (16 MHz / prescaler)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	6		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the EEPROM is busy for 3.3 ms after a write, a write
+//#			no longer advances the clock by itself
+//#		-	EEPROM ready interrupt
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	5		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	pin change interrupt 0 on a change of an enabled pin
+//#			of port B
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	4		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	Timer 0 compare B interrupt once per millisecond
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	3		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the universal pins are taken from board_pinout.h
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	access to the pins by universal pin numbering
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <stdarg.h>
+
+#include <Arduino.h>
+
+#include "board_pinout.h"
+#include "sim.h"
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+#define EEPROM_SIZE		(E2END + 1)
+#define EEPROM_WRITE_US	3300
+
+
+//==========================================================================
+//
+//		G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+//----------------------------------------------------------------------
+//	registers
+//
+volatile uint8_t	PINB;
+volatile uint8_t	DDRB;
+volatile uint8_t	PORTB;
+volatile uint8_t	PINC;
+volatile uint8_t	DDRC;
+volatile uint8_t	PORTC;
+volatile uint8_t	PIND;
+volatile uint8_t	DDRD;
+volatile uint8_t	PORTD;
+volatile uint8_t	PINE;
+volatile uint8_t	DDRE;
+volatile uint8_t	PORTE;
+volatile uint8_t	PINF;
+volatile uint8_t	DDRF;
+volatile uint8_t	PORTF;
+volatile uint8_t	SREG	= _BV( SREG_I );
+
+volatile uint8_t	TIMSK0;
+volatile uint8_t	OCR0B;
+
+volatile uint8_t	TCCR3A;
+volatile uint8_t	TCCR3B;
+volatile uint8_t	TCCR3C;
+volatile uint8_t	TIMSK3;
+volatile uint16_t	TCNT3;
+
+volatile uint8_t	PCICR;
+volatile uint8_t	PCIFR;
+volatile uint8_t	PCMSK0;
+
+volatile uint8_t	EECR;
+
+//----------------------------------------------------------------------
+//	interrupt routines of the firmware
+//	(weak, so the simulation also links without them)
+//
+extern "C" void TIMER0_COMPB_vect( void ) __attribute__(( weak ));
+extern "C" void PCINT0_vect( void ) __attribute__(( weak ));
+extern "C" void EE_READY_vect( void ) __attribute__(( weak ));
+
+//----------------------------------------------------------------------
+//	register sets per port, index is SIM_PORT_x
+//
+static volatile uint8_t * const	g_arSimPin[  SIM_PORT_COUNT ] = { &PINB,  &PINC,  &PIND,  &PINE,  &PINF  };
+static volatile uint8_t * const	g_arSimDdr[  SIM_PORT_COUNT ] = { &DDRB,  &DDRC,  &DDRD,  &DDRE,  &DDRF  };
+static volatile uint8_t * const	g_arSimPort[ SIM_PORT_COUNT ] = { &PORTB, &PORTC, &PORTD, &PORTE, &PORTF };
+
+//----------------------------------------------------------------------
+//	levels driven from outside (bit set = high)
+//	and mask of pins that are driven at all
+//
+static uint8_t			g_arSimExtLevel[  SIM_PORT_COUNT ];
+static uint8_t			g_arSimExtDriven[ SIM_PORT_COUNT ];
+
+//----------------------------------------------------------------------
+//	virtual clock in micro seconds
+//
+static uint64_t			g_ullSimMicros		= 0;
+static bool				g_bSimTimer0Pending	= false;
+static sim_tick_hook_t	g_arSimTickHooks[ SIM_MAX_TICK_HOOKS ];
+static uint8_t			g_usSimTickHooks	= 0;
+static bool				g_bSimInTick		= false;
+
+//----------------------------------------------------------------------
+//	Timer 3: time of the last update and cycles not yet counted
+//
+static uint64_t			g_ullSimTimer3Time	= 0;
+static uint32_t			g_ulSimTimer3Rest	= 0;
+
+//----------------------------------------------------------------------
+//	EEPROM
+//
+static uint8_t			g_arSimEeprom[ EEPROM_SIZE ];
+static FILE *			g_pSimEepromFile	= NULL;
+static bool				g_bSimEepromInit	= false;
+static uint64_t			g_ullSimEepromBusy	= 0;
+
+//----------------------------------------------------------------------
+//	USB serial interface: without a file the host has not opened
+//	the interface (DTR off)
+//
+static FILE *			g_pSimSerialFile	= NULL;
+static uint64_t			g_ullSimSerialFrame	= 0;
+static uint16_t			g_uiSimSerialSpace	= SIM_USB_ENDPOINT_SIZE;
+
+//----------------------------------------------------------------------
+//	log output
+//
+static FILE *			g_pSimLogFile		= stdout;
+
+Serial_					Serial;
+
+
+//==========================================================================
+//
+//		V I R T U A L   C L O C K
+//
+//==========================================================================
+
+//**************************************************************************
+//	SimSetClock
+//--------------------------------------------------------------------------
+//	sets the clock e.g. shortly before the millis() roll over
+//
+void SimSetClock( uint64_t ullMicros )
+{
+	g_ullSimMicros = ullMicros;
+}
+
+
+//**************************************************************************
+//	SimGetClock
+//--------------------------------------------------------------------------
+//
+uint64_t SimGetClock( void )
+{
+	return( g_ullSimMicros );
+}
+
+
+//**************************************************************************
+//	SimAddTickHook
+//--------------------------------------------------------------------------
+//
+bool SimAddTickHook( sim_tick_hook_t pHook )
+{
+	if( SIM_MAX_TICK_HOOKS <= g_usSimTickHooks )
+	{
+		return( false );
+	}
+
+	g_arSimTickHooks[ g_usSimTickHooks++ ] = pHook;
+
+	return( true );
+}
+
+
+//**************************************************************************
+//	SimInterrupts
+//--------------------------------------------------------------------------
+//	calls the interrupt routines of the firmware for all pending
+//	interrupts, if the interrupts are enabled
+//
+static void SimInterrupts( void )
+{
+	if( !(SREG & _BV( SREG_I )) || g_bSimInTick )
+	{
+		return;
+	}
+
+	g_bSimInTick = true;
+	SREG &= ~_BV( SREG_I );
+
+	//----	Timer 0 compare B (once per millisecond)  ------------------
+	if( g_bSimTimer0Pending )
+	{
+		g_bSimTimer0Pending = false;
+
+		if( (TIMSK0 & _BV( OCIE0B )) && (NULL != TIMER0_COMPB_vect) )
+		{
+			TIMER0_COMPB_vect();
+		}
+	}
+
+	//----	pin change 0  ----------------------------------------------
+	if( PCIFR & _BV( PCIF0 ) )
+	{
+		if( (PCICR & _BV( PCIE0 )) && (NULL != PCINT0_vect) )
+		{
+			PCIFR &= ~_BV( PCIF0 );
+
+			PCINT0_vect();
+		}
+	}
+
+	//----	EEPROM ready (as long as the EEPROM is ready)  -------------
+	while(		(EECR & _BV( EERIE )) && (NULL != EE_READY_vect)
+			&&	(g_ullSimMicros >= g_ullSimEepromBusy)				)
+	{
+		EE_READY_vect();
+	}
+
+	SREG |= _BV( SREG_I );
+	g_bSimInTick = false;
+}
+
+
+//**************************************************************************
+//	SimTimer3
+//--------------------------------------------------------------------------
+//	counts Timer 3 up to the virtual clock (16 cycles per micro second)
+//
+static void SimTimer3( void )
+{
+	static const uint16_t	aruiPrescaler[ 8 ]	= { 0, 1, 8, 64, 256, 1024, 0, 0 };
+
+	uint16_t	uiPrescaler	= aruiPrescaler[ TCCR3B & 0x07 ];
+	uint64_t	ullCycles	= ((g_ullSimMicros - g_ullSimTimer3Time) * 16) + g_ulSimTimer3Rest;
+
+	g_ullSimTimer3Time = g_ullSimMicros;
+
+	if( 0 == uiPrescaler )
+	{
+		//----	timer stopped  ---------------------------------------
+		g_ulSimTimer3Rest = 0;
+		return;
+	}
+
+	TCNT3				+= (uint16_t)(ullCycles / uiPrescaler);
+	g_ulSimTimer3Rest	 = (uint32_t)(ullCycles % uiPrescaler);
+}
+
+
+//**************************************************************************
+//	SimAdvance
+//--------------------------------------------------------------------------
+//	advances the virtual clock. Each time a millisecond boundary is
+//	passed the tick hooks are called.
+//	A tick hook itself may call delay() (e.g. via a simulated
+//	interrupt), in that case only the clock is advanced.
+//
+void SimAdvance( uint32_t ulMicros )
+{
+	uint64_t	ullTarget	= g_ullSimMicros + ulMicros;
+	uint64_t	ullNextTick;
+
+	if( g_bSimInTick )
+	{
+		g_ullSimMicros = ullTarget;
+		SimTimer3();
+		return;
+	}
+
+	while( g_ullSimMicros < ullTarget )
+	{
+		ullNextTick = ((g_ullSimMicros / 1000) + 1) * 1000;
+
+		if( ullNextTick > ullTarget )
+		{
+			g_ullSimMicros = ullTarget;
+		}
+		else
+		{
+			g_ullSimMicros	= ullNextTick;
+			g_bSimInTick	= true;
+
+			for( uint8_t idx = 0 ; idx < g_usSimTickHooks ; idx++ )
+			{
+				g_arSimTickHooks[ idx ]( (uint32_t)(g_ullSimMicros / 1000) );
+			}
+
+			g_bSimTimer0Pending = true;
+
+			g_bSimInTick = false;
+		}
+
+		SimInterrupts();
+	}
+
+	SimTimer3();
+	SimUpdatePins();
+}
+
+
+//**************************************************************************
+//	millis / micros / delay
+//--------------------------------------------------------------------------
+//
+uint32_t millis( void )
+{
+	return( (uint32_t)(g_ullSimMicros / 1000) );
+}
+
+
+uint32_t micros( void )
+{
+	return( (uint32_t)g_ullSimMicros );
+}
+
+
+void delay( uint32_t ulMillis )
+{
+	SimAdvance( ulMillis * 1000 );
+}
+
+
+void delayMicroseconds( uint16_t uiMicros )
+{
+	SimAdvance( uiMicros );
+}
+
+
+//==========================================================================
+//
+//		P O R T   P I N S
+//
+//==========================================================================
+
+//**************************************************************************
+//	SimSetPin
+//--------------------------------------------------------------------------
+//	drives a pin from outside (e.g. a contact pulling the pin low)
+//
+void SimSetPin( uint8_t usPort, uint8_t usBit, bool bHigh )
+{
+	if( SIM_PORT_COUNT > usPort )
+	{
+		g_arSimExtDriven[ usPort ] |= _BV( usBit );
+
+		if( bHigh )
+		{
+			g_arSimExtLevel[ usPort ] |=  _BV( usBit );
+		}
+		else
+		{
+			g_arSimExtLevel[ usPort ] &= ~_BV( usBit );
+		}
+
+		SimUpdatePins();
+	}
+}
+
+
+//**************************************************************************
+//	SimGetPortPin
+//--------------------------------------------------------------------------
+//	returns the level of a pin as the outside world sees it
+//
+bool SimGetPortPin( uint8_t usPort, uint8_t usBit )
+{
+	SimUpdatePins();
+
+	return( 0 != (*g_arSimPin[ usPort ] & _BV( usBit )) );
+}
+
+
+//**************************************************************************
+//	SimIsOutput
+//--------------------------------------------------------------------------
+//
+bool SimIsOutput( uint8_t usPort, uint8_t usBit )
+{
+	return( 0 != (*g_arSimDdr[ usPort ] & _BV( usBit )) );
+}
+
+
+//**************************************************************************
+//	SimUpdatePins
+//--------------------------------------------------------------------------
+//	calculates the PINx registers:
+//		-	output pins show the PORTx value
+//		-	driven input pins show the external level
+//		-	open input pins show the pull-up (PORTx bit)
+//	a change of a pin enabled in PCMSK0 sets the pin change flag
+//
+void SimUpdatePins( void )
+{
+	uint8_t	usDdr;
+	uint8_t	usPort;
+	uint8_t	usInput;
+	uint8_t	usOldPinB	= PINB;
+
+	for( uint8_t idx = 0 ; idx < SIM_PORT_COUNT ; idx++ )
+	{
+		usDdr	= *g_arSimDdr[  idx ];
+		usPort	= *g_arSimPort[ idx ];
+
+		usInput	=	(g_arSimExtLevel[ idx ] &  g_arSimExtDriven[ idx ])
+				|	(usPort                 & ~g_arSimExtDriven[ idx ]);
+
+		*g_arSimPin[ idx ] = (usPort & usDdr) | (usInput & ~usDdr);
+	}
+
+	//----	pin change 0 flag is set even if the interrupt is off  ----
+	if( (PINB ^ usOldPinB) & PCMSK0 )
+	{
+		PCIFR |= _BV( PCIF0 );
+	}
+}
+
+
+//**************************************************************************
+//	SimSetIOPin / SimGetIOPin / SimIsIOOutput
+//--------------------------------------------------------------------------
+//	the same as above, but for the universal pin numbering
+//
+//	the port IDs of board_pinout.h are the same as SIM_PORT_x
+//
+void SimSetIOPin( uint8_t usIOPin, bool bHigh )
+{
+	uint8_t	usPinCode = Board::PinCode( usIOPin % SIM_IO_NUMBERS );
+
+	SimSetPin( PIN_CODE_PORT( usPinCode ), PIN_CODE_BIT( usPinCode ), bHigh );
+}
+
+
+bool SimGetIOPin( uint8_t usIOPin )
+{
+	uint8_t	usPinCode = Board::PinCode( usIOPin % SIM_IO_NUMBERS );
+
+	return( SimGetPortPin( PIN_CODE_PORT( usPinCode ), PIN_CODE_BIT( usPinCode ) ) );
+}
+
+
+bool SimIsIOOutput( uint8_t usIOPin )
+{
+	uint8_t	usPinCode = Board::PinCode( usIOPin % SIM_IO_NUMBERS );
+
+	return( SimIsOutput( PIN_CODE_PORT( usPinCode ), PIN_CODE_BIT( usPinCode ) ) );
+}
+
+
+//==========================================================================
+//
+//		E E P R O M
+//
+//==========================================================================
+
+//**************************************************************************
+//	SimEepromInit
+//--------------------------------------------------------------------------
+//	a new chip comes with all cells set to 0xFF
+//
+static void SimEepromInit( void )
+{
+	if( !g_bSimEepromInit )
+	{
+		memset( g_arSimEeprom, 0xFF, EEPROM_SIZE );
+		g_bSimEepromInit = true;
+	}
+}
+
+
+//**************************************************************************
+//	SimEepromOpen
+//--------------------------------------------------------------------------
+//	loads the EEPROM content from the given file. Every write
+//	will be stored into this file immediately.
+//
+bool SimEepromOpen( const char *pchFileName )
+{
+	size_t	size;
+
+	SimEepromInit();
+
+	g_pSimEepromFile = fopen( pchFileName, "r+b" );
+
+	if( NULL == g_pSimEepromFile )
+	{
+		g_pSimEepromFile = fopen( pchFileName, "w+b" );
+
+		if( NULL == g_pSimEepromFile )
+		{
+			return( false );
+		}
+	}
+
+	//----------------------------------------------------------------
+	//	a new or too short file gets the content of an empty chip
+	//
+	size = fread( g_arSimEeprom, 1, EEPROM_SIZE, g_pSimEepromFile );
+
+	if( EEPROM_SIZE != size )
+	{
+		memset( g_arSimEeprom, 0xFF, EEPROM_SIZE );
+
+		fseek( g_pSimEepromFile, 0, SEEK_SET );
+		fwrite( g_arSimEeprom, 1, EEPROM_SIZE, g_pSimEepromFile );
+		fflush( g_pSimEepromFile );
+	}
+
+	return( true );
+}
+
+
+//**************************************************************************
+//	SimEepromStore
+//--------------------------------------------------------------------------
+//
+static void SimEepromStore( uint16_t uiAddress, uint8_t usValue )
+{
+	g_arSimEeprom[ uiAddress ] = usValue;
+
+	if( NULL != g_pSimEepromFile )
+	{
+		fseek( g_pSimEepromFile, uiAddress, SEEK_SET );
+		fputc( usValue, g_pSimEepromFile );
+		fflush( g_pSimEepromFile );
+	}
+}
+
+
+//**************************************************************************
+//	eeprom_is_ready / eeprom_busy_wait
+//--------------------------------------------------------------------------
+//	after a write the EEPROM is busy for EEPROM_WRITE_US
+//
+bool eeprom_is_ready( void )
+{
+	return( g_ullSimMicros >= g_ullSimEepromBusy );
+}
+
+
+void eeprom_busy_wait( void )
+{
+	if( g_ullSimMicros < g_ullSimEepromBusy )
+	{
+		SimAdvance( (uint32_t)(g_ullSimEepromBusy - g_ullSimMicros) );
+	}
+}
+
+
+//**************************************************************************
+//	eeprom_xxx
+//--------------------------------------------------------------------------
+//	the 'address' pointers are EEPROM addresses, not RAM addresses
+//	each access waits until the EEPROM is ready
+//
+uint8_t eeprom_read_byte( const uint8_t *puAddress )
+{
+	SimEepromInit();
+	eeprom_busy_wait();
+
+	return( g_arSimEeprom[ (uintptr_t)puAddress & E2END ] );
+}
+
+
+uint16_t eeprom_read_word( const uint16_t *puiAddress )
+{
+	uint16_t	uiAddress	= (uintptr_t)puiAddress & E2END;
+
+	SimEepromInit();
+	eeprom_busy_wait();
+
+	return(		g_arSimEeprom[ uiAddress ]
+			|	(g_arSimEeprom[ (uiAddress + 1) & E2END ] << 8) );
+}
+
+
+void eeprom_read_block( void *pDest, const void *pSource, size_t size )
+{
+	uint8_t *	pusDest		= (uint8_t *)pDest;
+	uint16_t	uiAddress	= (uintptr_t)pSource & E2END;
+
+	SimEepromInit();
+	eeprom_busy_wait();
+
+	while( size-- )
+	{
+		*pusDest++	= g_arSimEeprom[ uiAddress ];
+		uiAddress	= (uiAddress + 1) & E2END;
+	}
+}
+
+
+void eeprom_write_byte( uint8_t *puAddress, uint8_t usValue )
+{
+	SimEepromInit();
+	eeprom_busy_wait();
+	SimEepromStore( (uintptr_t)puAddress & E2END, usValue );
+
+	//----	one EEPROM write takes 3.3 ms  ----------------------------
+	g_ullSimEepromBusy = g_ullSimMicros + EEPROM_WRITE_US;
+}
+
+
+void eeprom_update_byte( uint8_t *puAddress, uint8_t usValue )
+{
+	if( eeprom_read_byte( puAddress ) != usValue )
+	{
+		eeprom_write_byte( puAddress, usValue );
+	}
+}
+
+
+void eeprom_write_word( uint16_t *puiAddress, uint16_t uiValue )
+{
+	eeprom_write_byte( (uint8_t *)puiAddress, uiValue & 0xFF );
+	eeprom_write_byte( (uint8_t *)puiAddress + 1, uiValue >> 8 );
+}
+
+
+void eeprom_update_word( uint16_t *puiAddress, uint16_t uiValue )
+{
+	if( eeprom_read_word( puiAddress ) != uiValue )
+	{
+		eeprom_write_word( puiAddress, uiValue );
+	}
+}
+
+
+//==========================================================================
+//
+//		U S B   S E R I A L
+//
+//==========================================================================
+
+//**************************************************************************
+//	SimSerialOpen
+//--------------------------------------------------------------------------
+//	all data written to 'Serial' goes into 'pFile'
+//
+void SimSerialOpen( FILE *pFile )
+{
+	g_pSimSerialFile = pFile;
+}
+
+
+//**************************************************************************
+//	SimSerialFrame
+//--------------------------------------------------------------------------
+//	with each new frame the endpoint is empty again
+//
+static void SimSerialFrame( void )
+{
+	if( (g_ullSimMicros / 1000) != g_ullSimSerialFrame )
+	{
+		g_ullSimSerialFrame	= g_ullSimMicros / 1000;
+		g_uiSimSerialSpace	= SIM_USB_ENDPOINT_SIZE;
+	}
+}
+
+
+//**************************************************************************
+//	Serial_
+//--------------------------------------------------------------------------
+//
+void Serial_::begin( uint32_t )
+{
+}
+
+
+bool Serial_::dtr( void )
+{
+	return( NULL != g_pSimSerialFile );
+}
+
+
+int Serial_::availableForWrite( void )
+{
+	SimSerialFrame();
+
+	return( dtr() ? g_uiSimSerialSpace : 0 );
+}
+
+
+//**************************************************************************
+//	Serial_::write
+//--------------------------------------------------------------------------
+//	like on the board the function waits for the next frame if the
+//	endpoint is full
+//
+size_t Serial_::write( const uint8_t *pBuffer, size_t size )
+{
+	size_t	sizeDone	= 0;
+	size_t	sizePart;
+
+	if( !dtr() )
+	{
+		return( 0 );
+	}
+
+	while( sizeDone < size )
+	{
+		SimSerialFrame();
+
+		if( 0 == g_uiSimSerialSpace )
+		{
+			SimAdvance( 1000 - (g_ullSimMicros % 1000) );
+			continue;
+		}
+
+		sizePart = size - sizeDone;
+
+		if( sizePart > g_uiSimSerialSpace )
+		{
+			sizePart = g_uiSimSerialSpace;
+		}
+
+		fwrite( pBuffer + sizeDone, 1, sizePart, g_pSimSerialFile );
+
+		g_uiSimSerialSpace	-= sizePart;
+		sizeDone			+= sizePart;
+	}
+
+	fflush( g_pSimSerialFile );
+
+	return( size );
+}
+
+
+//==========================================================================
+//
+//		O U T P U T
+//
+//==========================================================================
+
+//**************************************************************************
+//	SimSetLogFile
+//--------------------------------------------------------------------------
+//
+void SimSetLogFile( FILE *pFile )
+{
+	g_pSimLogFile = pFile;
+}
+
+
+//**************************************************************************
+//	SimLog
+//--------------------------------------------------------------------------
+//	prints one line with the virtual time in front
+//
+void SimLog( const char *pchFormat, ... )
+{
+	va_list	args;
+
+	if( NULL == g_pSimLogFile )
+	{
+		return;
+	}
+
+	fprintf(	g_pSimLogFile, "%10llu.%03llu  ",
+				(unsigned long long)(g_ullSimMicros / 1000),
+				(unsigned long long)(g_ullSimMicros % 1000)		);
+
+	va_start( args, pchFormat );
+	vfprintf( g_pSimLogFile, pchFormat, args );
+	va_end( args );
+
+	fputc( '\n', g_pSimLogFile );
+}
@@ -0,0 +1,178 @@
+//##########################################################################
+//#
+//#		Simulation of the OLED display
+//#
+//#	The display is kept as 8 lines with 16 characters each.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <simple_oled_sh1106.h>
+
+
+//==========================================================================
+//
+//		G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+SimpleOledClass		g_clDisplay;
+
+
+//==========================================================================
+//
+//		C L A S S   F U N C T I O N S
+//
+//==========================================================================
+
+//**************************************************************************
+//	Constructor
+//--------------------------------------------------------------------------
+//
+SimpleOledClass::SimpleOledClass()
+{
+	m_ulWriteCount = 0;
+
+	Clear();
+}
+
+
+//**************************************************************************
+//	Init / Flip / SetInverseFont
+//--------------------------------------------------------------------------
+//
+void SimpleOledClass::Init( void )
+{
+	Clear();
+}
+
+
+void SimpleOledClass::Flip( bool )
+{
+}
+
+
+void SimpleOledClass::SetInverseFont( bool )
+{
+}
+
+
+//**************************************************************************
+//	Clear
+//--------------------------------------------------------------------------
+//
+void SimpleOledClass::Clear( void )
+{
+	for( uint8_t idx = 0 ; idx < OLED_LINES ; idx++ )
+	{
+		memset( m_arScreen[ idx ], ' ', OLED_COLUMNS );
+		m_arScreen[ idx ][ OLED_COLUMNS ] = '\0';
+	}
+
+	m_usLine	= 0;
+	m_usColumn	= 0;
+}
+
+
+//**************************************************************************
+//	ClearLine
+//--------------------------------------------------------------------------
+//
+void SimpleOledClass::ClearLine( uint8_t usLine )
+{
+	if( OLED_LINES > usLine )
+	{
+		memset( m_arScreen[ usLine ], ' ', OLED_COLUMNS );
+		m_ulWriteCount += OLED_COLUMNS;
+	}
+
+	m_usLine	= usLine;
+	m_usColumn	= 0;
+}
+
+
+//**************************************************************************
+//	SetCursor
+//--------------------------------------------------------------------------
+//
+void SimpleOledClass::SetCursor( uint8_t usLine, uint8_t usColumn )
+{
+	m_usLine	= usLine;
+	m_usColumn	= usColumn;
+}
+
+
+//**************************************************************************
+//	Print
+//--------------------------------------------------------------------------
+//
+void SimpleOledClass::Print( const char *pchText )
+{
+	while( *pchText )
+	{
+		if( '\n' == *pchText )
+		{
+			m_usLine++;
+			m_usColumn = 0;
+		}
+		else
+		{
+			if( (OLED_LINES > m_usLine) && (OLED_COLUMNS > m_usColumn) )
+			{
+				m_arScreen[ m_usLine ][ m_usColumn ] = *pchText;
+				m_ulWriteCount++;
+			}
+
+			m_usColumn++;
+		}
+
+		pchText++;
+	}
+}
+
+
+void SimpleOledClass::Print( const __FlashStringHelper *pText )
+{
+	Print( reinterpret_cast< const char * >( pText ) );
+}
+
+
+//**************************************************************************
+//	Dump
+//--------------------------------------------------------------------------
+//
+void SimpleOledClass::Dump( FILE *pFile )
+{
+	fprintf( pFile, "+----------------+\n" );
+
+	for( uint8_t idx = 0 ; idx < OLED_LINES ; idx++ )
+	{
+		fprintf( pFile, "|%s|\n", m_arScreen[ idx ] );
+	}
+
+	fprintf( pFile, "+----------------+\n" );
+}
+
+
+//**************************************************************************
+//	GetWriteCount
+//--------------------------------------------------------------------------
+//	number of characters sent to the display so far
+//
+uint32_t SimpleOledClass::GetWriteCount( void )
+{
+	return( m_ulWriteCount );
+}
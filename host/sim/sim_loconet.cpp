@@ -0,0 +1,463 @@
+//##########################################################################
+//#
+//#		Simulation of the LocoNet bus
+//#
+//#	-	messages sent by the firmware are logged and, like on the real
+//#		bus, received again by the sender (echo)
+//#	-	the scenario script injects messages of other devices
+//#	-	switch and sensor messages are decoded as the LocoNet library
+//#		does and delivered to the notifyXxx() callbacks
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <Arduino.h>
+#include <LocoNet.h>
+
+#include "sim.h"
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+#define SIM_RX_QUEUE_SIZE		64
+
+
+//==========================================================================
+//
+//		G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+LocoNetClass	LocoNet;
+
+static lnMsg	g_arSimRxQueue[ SIM_RX_QUEUE_SIZE ];
+static uint8_t	g_usSimRxRead		= 0;
+static uint8_t	g_usSimRxWrite		= 0;
+static lnMsg	g_SimRxPacket;
+static uint32_t	g_ulSimSendCount	= 0;
+static bool		g_bSimEcho			= true;
+
+
+//==========================================================================
+//
+//		H E L P E R   F U N C T I O N S
+//
+//==========================================================================
+
+//**************************************************************************
+//	SimBusChecksum
+//--------------------------------------------------------------------------
+//
+static void SimBusChecksum( lnMsg *pMsg, uint8_t usLength )
+{
+	uint8_t	usCheck = 0xFF;
+
+	for( uint8_t idx = 0 ; idx < (usLength - 1) ; idx++ )
+	{
+		usCheck ^= pMsg->data[ idx ];
+	}
+
+	pMsg->data[ usLength - 1 ] = usCheck;
+}
+
+
+//**************************************************************************
+//	SimBusDecodeSwitchAddress
+//--------------------------------------------------------------------------
+//
+static uint16_t SimBusDecodeSwitchAddress( const lnMsg *pMsg )
+{
+	return( (pMsg->data[ 1 ] | ((pMsg->data[ 2 ] & 0x0F) << 7)) + 1 );
+}
+
+
+//**************************************************************************
+//	SimBusDecodeSensorAddress
+//--------------------------------------------------------------------------
+//
+static uint16_t SimBusDecodeSensorAddress( const lnMsg *pMsg )
+{
+	uint16_t	uiAddress = pMsg->data[ 1 ] | ((pMsg->data[ 2 ] & 0x0F) << 7);
+
+	uiAddress <<= 1;
+	uiAddress  += (pMsg->data[ 2 ] & OPC_INPUT_REP_SW) ? 2 : 1;
+
+	return( uiAddress );
+}
+
+
+//**************************************************************************
+//	SimBusPrint
+//--------------------------------------------------------------------------
+//
+static void SimBusPrint( const char *pchPrefix, const lnMsg *pMsg )
+{
+	switch( pMsg->data[ 0 ] )
+	{
+		case OPC_INPUT_REP:
+			SimLog(	"%s SENSOR adr=%u state=%u", pchPrefix,
+					SimBusDecodeSensorAddress( pMsg ),
+					(pMsg->data[ 2 ] & OPC_INPUT_REP_HI) ? 1 : 0	);
+			break;
+
+		case OPC_SW_REQ:
+		case OPC_SW_REP:
+		case OPC_SW_STATE:
+			SimLog(	"%s SWITCH adr=%u out=%u dir=%u", pchPrefix,
+					SimBusDecodeSwitchAddress( pMsg ),
+					(pMsg->data[ 2 ] & OPC_SW_REQ_OUT) ? 1 : 0,
+					(pMsg->data[ 2 ] & OPC_SW_REQ_DIR) ? 1 : 0		);
+			break;
+
+		default:
+			SimLog( "%s OPC=0x%02X", pchPrefix, pMsg->data[ 0 ] );
+			break;
+	}
+}
+
+
+//==========================================================================
+//
+//		S I M U L A T I O N   I N T E R F A C E
+//
+//==========================================================================
+
+//**************************************************************************
+//	SimBusInject
+//--------------------------------------------------------------------------
+//	puts a message into the receive queue of the firmware
+//
+void SimBusInject( const lnMsg *pMsg )
+{
+	uint8_t	usNext = (g_usSimRxWrite + 1) % SIM_RX_QUEUE_SIZE;
+
+	if( usNext == g_usSimRxRead )
+	{
+		SimLog( "BUS RX queue overflow" );
+		return;
+	}
+
+	g_arSimRxQueue[ g_usSimRxWrite ]	= *pMsg;
+	g_usSimRxWrite						= usNext;
+}
+
+
+//**************************************************************************
+//	SimBusGetSendCount
+//--------------------------------------------------------------------------
+//
+uint32_t SimBusGetSendCount( void )
+{
+	return( g_ulSimSendCount );
+}
+
+
+//**************************************************************************
+//	SimBusSetEcho
+//--------------------------------------------------------------------------
+//
+void SimBusSetEcho( bool bEcho )
+{
+	g_bSimEcho = bEcho;
+}
+
+
+//**************************************************************************
+//	SimBusEncodeSensor
+//--------------------------------------------------------------------------
+//
+void SimBusEncodeSensor( lnMsg *pMsg, uint16_t uiAddress, uint8_t usState )
+{
+	uint16_t	uiAdr = uiAddress - 1;
+
+	pMsg->data[ 0 ] = OPC_INPUT_REP;
+	pMsg->data[ 1 ] = (uiAdr >> 1) & 0x7F;
+	pMsg->data[ 2 ] =	((uiAdr >> 8) & 0x0F)
+					|	OPC_INPUT_REP_X
+					|	((uiAdr & 0x0001) ? OPC_INPUT_REP_SW : 0)
+					|	(usState ? OPC_INPUT_REP_HI : 0);
+
+	SimBusChecksum( pMsg, 4 );
+}
+
+
+//**************************************************************************
+//	SimBusEncodeSwitch
+//--------------------------------------------------------------------------
+//
+void SimBusEncodeSwitch(	lnMsg *pMsg, uint8_t usOpCode, uint16_t uiAddress,
+							uint8_t usOutput, uint8_t usDirection				)
+{
+	uint16_t	uiAdr = uiAddress - 1;
+
+	pMsg->data[ 0 ] = usOpCode;
+	pMsg->data[ 1 ] = uiAdr & 0x7F;
+	pMsg->data[ 2 ] =	((uiAdr >> 7) & 0x0F)
+					|	(usOutput    ? OPC_SW_REQ_OUT : 0)
+					|	(usDirection ? OPC_SW_REQ_DIR : 0);
+
+	SimBusChecksum( pMsg, 4 );
+}
+
+
+//**************************************************************************
+//	SimBusEncodeLncv
+//--------------------------------------------------------------------------
+//	simplified LNCV message, the parameters are carried as they are
+//
+void SimBusEncodeLncv(	lnMsg *pMsg, uint8_t usCommand, uint16_t uiArticle,
+						uint16_t uiAddress, uint16_t uiValue				)
+{
+	memset( pMsg, 0, sizeof( lnMsg ) );
+
+	pMsg->data[ 0 ] = OPC_PEER_XFER;
+	pMsg->data[ 1 ] = 15;
+	pMsg->data[ 2 ] = usCommand;
+	pMsg->data[ 3 ] = uiArticle & 0xFF;
+	pMsg->data[ 4 ] = uiArticle >> 8;
+	pMsg->data[ 5 ] = uiAddress & 0xFF;
+	pMsg->data[ 6 ] = uiAddress >> 8;
+	pMsg->data[ 7 ] = uiValue & 0xFF;
+	pMsg->data[ 8 ] = uiValue >> 8;
+}
+
+
+//==========================================================================
+//
+//		L O C O N E T   C L A S S
+//
+//==========================================================================
+
+//**************************************************************************
+//	init
+//--------------------------------------------------------------------------
+//
+void LocoNetClass::init( uint8_t )
+{
+}
+
+
+//**************************************************************************
+//	receive
+//--------------------------------------------------------------------------
+//
+lnMsg * LocoNetClass::receive( void )
+{
+	if( g_usSimRxRead == g_usSimRxWrite )
+	{
+		return( NULL );
+	}
+
+	g_SimRxPacket	= g_arSimRxQueue[ g_usSimRxRead ];
+	g_usSimRxRead	= (g_usSimRxRead + 1) % SIM_RX_QUEUE_SIZE;
+
+	return( &g_SimRxPacket );
+}
+
+
+//**************************************************************************
+//	send
+//--------------------------------------------------------------------------
+//	sending blocks as long as the real transmission would take
+//
+LN_STATUS LocoNetClass::send( lnMsg *TxPacket )
+{
+	g_ulSimSendCount++;
+
+	SimAdvance( SIM_LN_SEND_TIME_US );
+	SimBusPrint( "TX", TxPacket );
+
+	if( g_bSimEcho )
+	{
+		SimBusInject( TxPacket );
+	}
+
+	return( LN_DONE );
+}
+
+
+//**************************************************************************
+//	requestSwitch
+//--------------------------------------------------------------------------
+//
+LN_STATUS LocoNetClass::requestSwitch( uint16_t Address, uint8_t Output, uint8_t Direction )
+{
+	lnMsg	msg;
+
+	SimBusEncodeSwitch( &msg, OPC_SW_REQ, Address, Output, Direction );
+
+	return( send( &msg ) );
+}
+
+
+//**************************************************************************
+//	reportSwitch
+//--------------------------------------------------------------------------
+//
+LN_STATUS LocoNetClass::reportSwitch( uint16_t Address )
+{
+	lnMsg	msg;
+
+	SimBusEncodeSwitch( &msg, OPC_SW_STATE, Address, 0, 0 );
+
+	return( send( &msg ) );
+}
+
+
+//**************************************************************************
+//	reportSensor
+//--------------------------------------------------------------------------
+//
+LN_STATUS LocoNetClass::reportSensor( uint16_t Address, uint8_t State )
+{
+	lnMsg	msg;
+
+	SimBusEncodeSensor( &msg, Address, State );
+
+	return( send( &msg ) );
+}
+
+
+//**************************************************************************
+//	processSwitchSensorMessage
+//--------------------------------------------------------------------------
+//	the flags are given to the callbacks as masked bits,
+//	just as the LocoNet library does
+//
+uint8_t LocoNetClass::processSwitchSensorMessage( lnMsg *LnPacket )
+{
+	uint8_t		usOutput	= LnPacket->data[ 2 ] & OPC_SW_REQ_OUT;
+	uint8_t		usDirection	= LnPacket->data[ 2 ] & OPC_SW_REQ_DIR;
+
+	switch( LnPacket->data[ 0 ] )
+	{
+		case OPC_INPUT_REP:
+			if( notifySensor )
+			{
+				notifySensor(	SimBusDecodeSensorAddress( LnPacket ),
+								LnPacket->data[ 2 ] & OPC_INPUT_REP_HI	);
+			}
+			return( 1 );
+
+		case OPC_SW_REQ:
+			if( notifySwitchRequest )
+			{
+				notifySwitchRequest( SimBusDecodeSwitchAddress( LnPacket ), usOutput, usDirection );
+			}
+			return( 1 );
+
+		case OPC_SW_REP:
+			if( notifySwitchReport )
+			{
+				notifySwitchReport( SimBusDecodeSwitchAddress( LnPacket ), usOutput, usDirection );
+			}
+			return( 1 );
+
+		case OPC_SW_STATE:
+			if( notifySwitchState )
+			{
+				notifySwitchState( SimBusDecodeSwitchAddress( LnPacket ), usOutput, usDirection );
+			}
+			return( 1 );
+
+		default:
+			break;
+	}
+
+	return( 0 );
+}
+
+
+//==========================================================================
+//
+//		L O C O N E T   C V   C L A S S
+//
+//==========================================================================
+
+//**************************************************************************
+//	processLNCVMessage
+//--------------------------------------------------------------------------
+//	calls the LNCV callbacks and logs the answer the module would send
+//
+bool LocoNetCVClass::processLNCVMessage( lnMsg *LnPacket )
+{
+	uint16_t	uiArticle;
+	uint16_t	uiAddress;
+	uint16_t	uiValue;
+	int8_t		retval		= -1;
+
+	if( OPC_PEER_XFER != LnPacket->data[ 0 ] )
+	{
+		return( false );
+	}
+
+	uiArticle	= LnPacket->data[ 3 ] | (LnPacket->data[ 4 ] << 8);
+	uiAddress	= LnPacket->data[ 5 ] | (LnPacket->data[ 6 ] << 8);
+	uiValue		= LnPacket->data[ 7 ] | (LnPacket->data[ 8 ] << 8);
+
+	switch( LnPacket->data[ 2 ] )
+	{
+		case LNCV_SIM_DISCOVER:
+			if( notifyLNCVdiscover )
+			{
+				retval = notifyLNCVdiscover( uiArticle, uiAddress );
+				SimLog( "LNCV discover ret=%d art=%u mod=%u", retval, uiArticle, uiAddress );
+			}
+			break;
+
+		case LNCV_SIM_PROG_START:
+			if( notifyLNCVprogrammingStart )
+			{
+				retval = notifyLNCVprogrammingStart( uiArticle, uiAddress );
+				SimLog( "LNCV start ret=%d art=%u mod=%u", retval, uiArticle, uiAddress );
+			}
+			break;
+
+		case LNCV_SIM_PROG_STOP:
+			if( notifyLNCVprogrammingStop )
+			{
+				notifyLNCVprogrammingStop( uiArticle, uiAddress );
+				SimLog( "LNCV stop art=%u mod=%u", uiArticle, uiAddress );
+			}
+			break;
+
+		case LNCV_SIM_READ:
+			if( notifyLNCVread )
+			{
+				uiValue	= 0;
+				retval	= notifyLNCVread( uiArticle, uiAddress, 0, uiValue );
+				SimLog( "LNCV read ret=%d lncv=%u value=%u", retval, uiAddress, uiValue );
+			}
+			break;
+
+		case LNCV_SIM_WRITE:
+			if( notifyLNCVwrite )
+			{
+				retval = notifyLNCVwrite( uiArticle, uiAddress, uiValue );
+				SimLog( "LNCV write ret=%d lncv=%u value=%u", retval, uiAddress, uiValue );
+			}
+			break;
+
+		default:
+			return( false );
+	}
+
+	return( true );
+}
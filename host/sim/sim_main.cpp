@@ -0,0 +1,569 @@
+//##########################################################################
+//#
+//#		Scenario runner
+//#
+//#	Runs setup() and loop() of the firmware on the virtual clock and
+//#	feeds them with a scripted scenario.
+//#
+//#	Usage:
+//#		fremo_uni_io_sim <scenario file> [--eeprom <file>] [--trace <file>]
+//#
+//#	With '--trace' the host has opened the USB serial interface and
+//#	all data the firmware sends is written into the file
+//#	(compile option USB_TRACE, decoded by fremo_uni_io_trace).
+//#
+//#	Scenario file, one command per line, '#' starts a comment:
+//#		set loopcost <us>			time one loop() pass takes
+//#		set clock <ms>				start value of millis()
+//#		<ms> io <pin> <0|1>			drive universal pin (0 = low = active)
+//#		<ms> sensor <adr> <0|1>		sensor report from another device
+//#		<ms> switch <adr> <0|1>		switch request from another device
+//#		<ms> lncv discover <art>
+//#		<ms> lncv start <art> <module>
+//#		<ms> lncv stop  <art> <module>
+//#		<ms> lncv read  <art> <lncv>
+//#		<ms> lncv write <art> <lncv> <value>
+//#		<ms> display				print the OLED content
+//#		<ms> end					end of the simulation
+//#	The times are relative to the start of the simulation.
+//#
+//#	Output, one line per event with the virtual time in front:
+//#		TX ...						message sent by the firmware
+//#		OUT io=<pin> level=<0|1>	universal output pin changed
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	5		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the firmware does not reset itself any more, the restart
+//#			of the simulator process is removed
+//#			removed functions
+//#				Restart()
+//#				Resume()
+//#			removed options '--resume' and '--temp-eeprom'
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	4		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new option '--trace': data of the USB serial interface
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	3		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	'display' also logs the number of characters sent to the
+//#			display so far
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the table of the universal pins moved to sim_arduino.cpp
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <unistd.h>
+
+#include <Arduino.h>
+#include <LocoNet.h>
+#include <simple_oled_sh1106.h>
+
+#include "sim.h"
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+#define IO_NUMBERS				16
+#define MAX_EVENTS				1024
+#define DEFAULT_LOOP_COST_US	50
+
+
+typedef enum sim_command
+{
+	SC_IO = 0,
+	SC_SENSOR,
+	SC_SWITCH,
+	SC_LNCV,
+	SC_DISPLAY,
+	SC_END
+
+}	sim_command_t;
+
+
+typedef struct sim_event
+{
+	uint32_t		ulTime;
+	sim_command_t	command;
+	uint8_t			usLncvCommand;
+	uint16_t		aruiArg[ 3 ];
+
+}	sim_event_t;
+
+
+//==========================================================================
+//
+//		F U N C T I O N   D E C L A R A T I O N
+//
+//==========================================================================
+
+//----	firmware  ------------------------------------------------------
+void setup( void );
+void loop( void );
+
+
+//==========================================================================
+//
+//		G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+static sim_event_t	g_arEvents[ MAX_EVENTS ];
+static uint16_t		g_uiEventCount		= 0;
+static uint16_t		g_uiNextEvent		= 0;
+static uint32_t		g_ulStartTime		= 0;
+static uint32_t		g_ulLoopCost		= DEFAULT_LOOP_COST_US;
+static bool			g_bEnd				= false;
+static uint16_t		g_uiOutputLevel		= 0;
+static uint16_t		g_uiOutputMask		= 0;
+static const char *	g_pchScenario		= NULL;
+static const char *	g_pchEeprom			= NULL;
+static bool			g_bTempEeprom		= false;
+static const char *	g_pchTrace			= NULL;
+
+
+//==========================================================================
+//
+//		F U N C T I O N S
+//
+//==========================================================================
+
+//**************************************************************************
+//	ParseLine
+//--------------------------------------------------------------------------
+//
+static bool ParseLine( char *pchLine, uint16_t uiLineNumber )
+{
+	sim_event_t	event;
+	char		chCommand[ 16 ];
+	char		chSub[ 16 ];
+	unsigned	arArg[ 3 ]	= { 0, 0, 0 };
+	unsigned	uTime;
+	char *		pchComment	= strchr( pchLine, '#' );
+
+	if( NULL != pchComment )
+	{
+		*pchComment = '\0';
+	}
+
+	if( 1 != sscanf( pchLine, " %15s", chCommand ) )
+	{
+		return( true );		//	empty line
+	}
+
+	if( 0 == strcmp( chCommand, "set" ) )
+	{
+		if( 2 != sscanf( pchLine, " set %15s %u", chSub, &arArg[ 0 ] ) )
+		{
+			fprintf( stderr, "line %u: syntax error\n", uiLineNumber );
+			return( false );
+		}
+
+		if( 0 == strcmp( chSub, "loopcost" ) )
+		{
+			g_ulLoopCost = arArg[ 0 ];
+		}
+		else if( 0 == strcmp( chSub, "clock" ) )
+		{
+			g_ulStartTime = arArg[ 0 ];
+		}
+		else
+		{
+			fprintf( stderr, "line %u: unknown setting '%s'\n", uiLineNumber, chSub );
+			return( false );
+		}
+
+		return( true );
+	}
+
+	if( 2 != sscanf( pchLine, " %u %15s", &uTime, chCommand ) )
+	{
+		fprintf( stderr, "line %u: syntax error\n", uiLineNumber );
+		return( false );
+	}
+
+	memset( &event, 0, sizeof( event ) );
+	event.ulTime = uTime;
+
+	if( 0 == strcmp( chCommand, "io" ) )
+	{
+		event.command = SC_IO;
+
+		if( 2 != sscanf( pchLine, " %*u %*s %u %u", &arArg[ 0 ], &arArg[ 1 ] ) )
+		{
+			fprintf( stderr, "line %u: io <pin> <level>\n", uiLineNumber );
+			return( false );
+		}
+	}
+	else if( 0 == strcmp( chCommand, "sensor" ) )
+	{
+		event.command = SC_SENSOR;
+
+		if( 2 != sscanf( pchLine, " %*u %*s %u %u", &arArg[ 0 ], &arArg[ 1 ] ) )
+		{
+			fprintf( stderr, "line %u: sensor <address> <state>\n", uiLineNumber );
+			return( false );
+		}
+	}
+	else if( 0 == strcmp( chCommand, "switch" ) )
+	{
+		event.command = SC_SWITCH;
+
+		if( 2 != sscanf( pchLine, " %*u %*s %u %u", &arArg[ 0 ], &arArg[ 1 ] ) )
+		{
+			fprintf( stderr, "line %u: switch <address> <direction>\n", uiLineNumber );
+			return( false );
+		}
+	}
+	else if( 0 == strcmp( chCommand, "lncv" ) )
+	{
+		event.command = SC_LNCV;
+
+		if( 2 > sscanf(	pchLine, " %*u %*s %15s %u %u %u",
+						chSub, &arArg[ 0 ], &arArg[ 1 ], &arArg[ 2 ] ) )
+		{
+			fprintf( stderr, "line %u: lncv <command> <article> ...\n", uiLineNumber );
+			return( false );
+		}
+
+		if( 0 == strcmp( chSub, "discover" ) )
+		{
+			event.usLncvCommand = LNCV_SIM_DISCOVER;
+		}
+		else if( 0 == strcmp( chSub, "start" ) )
+		{
+			event.usLncvCommand = LNCV_SIM_PROG_START;
+		}
+		else if( 0 == strcmp( chSub, "stop" ) )
+		{
+			event.usLncvCommand = LNCV_SIM_PROG_STOP;
+		}
+		else if( 0 == strcmp( chSub, "read" ) )
+		{
+			event.usLncvCommand = LNCV_SIM_READ;
+		}
+		else if( 0 == strcmp( chSub, "write" ) )
+		{
+			event.usLncvCommand = LNCV_SIM_WRITE;
+		}
+		else
+		{
+			fprintf( stderr, "line %u: unknown lncv command '%s'\n", uiLineNumber, chSub );
+			return( false );
+		}
+	}
+	else if( 0 == strcmp( chCommand, "display" ) )
+	{
+		event.command = SC_DISPLAY;
+	}
+	else if( 0 == strcmp( chCommand, "end" ) )
+	{
+		event.command = SC_END;
+	}
+	else
+	{
+		fprintf( stderr, "line %u: unknown command '%s'\n", uiLineNumber, chCommand );
+		return( false );
+	}
+
+	if( MAX_EVENTS <= g_uiEventCount )
+	{
+		fprintf( stderr, "line %u: too many events\n", uiLineNumber );
+		return( false );
+	}
+
+	for( uint8_t idx = 0 ; idx < 3 ; idx++ )
+	{
+		event.aruiArg[ idx ] = (uint16_t)arArg[ idx ];
+	}
+
+	g_arEvents[ g_uiEventCount++ ] = event;
+
+	return( true );
+}
+
+
+//**************************************************************************
+//	LoadScenario
+//--------------------------------------------------------------------------
+//
+static bool LoadScenario( const char *pchFileName )
+{
+	char		chLine[ 256 ];
+	uint16_t	uiLineNumber	= 0;
+	FILE *		pFile			= fopen( pchFileName, "r" );
+
+	if( NULL == pFile )
+	{
+		fprintf( stderr, "can't open scenario '%s'\n", pchFileName );
+		return( false );
+	}
+
+	while( NULL != fgets( chLine, sizeof( chLine ), pFile ) )
+	{
+		uiLineNumber++;
+
+		if( !ParseLine( chLine, uiLineNumber ) )
+		{
+			fclose( pFile );
+			return( false );
+		}
+	}
+
+	fclose( pFile );
+
+	return( true );
+}
+
+
+//**************************************************************************
+//	ExecuteEvent
+//--------------------------------------------------------------------------
+//
+static void ExecuteEvent( const sim_event_t *pEvent )
+{
+	lnMsg	msg;
+	uint8_t	usPin;
+
+	switch( pEvent->command )
+	{
+		case SC_IO:
+			usPin = pEvent->aruiArg[ 0 ] % IO_NUMBERS;
+
+			SimLog( "IN  io=%u level=%u", usPin, pEvent->aruiArg[ 1 ] ? 1 : 0 );
+			SimSetIOPin( usPin, 0 != pEvent->aruiArg[ 1 ] );
+			break;
+
+		case SC_SENSOR:
+			SimBusEncodeSensor( &msg, pEvent->aruiArg[ 0 ], pEvent->aruiArg[ 1 ] );
+			SimBusInject( &msg );
+			break;
+
+		case SC_SWITCH:
+			SimBusEncodeSwitch( &msg, OPC_SW_REQ, pEvent->aruiArg[ 0 ], 1, pEvent->aruiArg[ 1 ] );
+			SimBusInject( &msg );
+			break;
+
+		case SC_LNCV:
+			SimBusEncodeLncv(	&msg, pEvent->usLncvCommand, pEvent->aruiArg[ 0 ],
+								pEvent->aruiArg[ 1 ], pEvent->aruiArg[ 2 ]			);
+			SimBusInject( &msg );
+			break;
+
+		case SC_DISPLAY:
+			SimLog( "DISPLAY chars=%lu", (unsigned long)g_clDisplay.GetWriteCount() );
+			g_clDisplay.Dump( stdout );
+			break;
+
+		case SC_END:
+			g_bEnd = true;
+			break;
+	}
+}
+
+
+//**************************************************************************
+//	ScenarioTick
+//--------------------------------------------------------------------------
+//	called by the virtual clock every millisecond
+//
+static void ScenarioTick( uint32_t ulMillis )
+{
+	uint32_t	ulElapsed = ulMillis - g_ulStartTime;
+
+	while(		(g_uiNextEvent < g_uiEventCount)
+			&&	(g_arEvents[ g_uiNextEvent ].ulTime <= ulElapsed) )
+	{
+		ExecuteEvent( &g_arEvents[ g_uiNextEvent ] );
+		g_uiNextEvent++;
+	}
+}
+
+
+//**************************************************************************
+//	CheckOutputs
+//--------------------------------------------------------------------------
+//	logs every change of a universal pin that is configured as output
+//
+static void CheckOutputs( void )
+{
+	uint16_t	uiMask		= 0x0001;
+	uint16_t	uiLevel		= 0;
+	uint16_t	uiOutputs	= 0;
+
+	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
+	{
+		if( SimIsIOOutput( idx ) )
+		{
+			uiOutputs |= uiMask;
+
+			if( SimGetIOPin( idx ) )
+			{
+				uiLevel |= uiMask;
+			}
+
+			if(		(g_uiOutputMask & uiMask)
+				&&	((g_uiOutputLevel ^ uiLevel) & uiMask) )
+			{
+				SimLog( "OUT io=%u level=%u", idx, (uiLevel & uiMask) ? 1 : 0 );
+			}
+		}
+
+		uiMask <<= 1;
+	}
+
+	g_uiOutputMask	= uiOutputs;
+	g_uiOutputLevel	= uiLevel;
+}
+
+
+//**************************************************************************
+//	OpenEeprom
+//--------------------------------------------------------------------------
+//	without an EEPROM file a temporary one is used, it is
+//	removed at the end
+//
+static bool OpenEeprom( void )
+{
+	static char	chTempName[] = "/tmp/fremo_uni_io_eeprom_XXXXXX";
+	int			iFile;
+
+	if( NULL == g_pchEeprom )
+	{
+		iFile = mkstemp( chTempName );
+
+		if( 0 > iFile )
+		{
+			return( false );
+		}
+
+		close( iFile );
+
+		g_pchEeprom		= chTempName;
+		g_bTempEeprom	= true;
+	}
+
+	return( SimEepromOpen( g_pchEeprom ) );
+}
+
+
+//**************************************************************************
+//	main
+//--------------------------------------------------------------------------
+//
+int main( int argc, char *argv[] )
+{
+	uint32_t	ulLoops		= 0;
+	FILE *		pTraceFile	= NULL;
+
+	for( int idx = 1 ; idx < argc ; idx++ )
+	{
+		if( (0 == strcmp( argv[ idx ], "--eeprom" )) && ((idx + 1) < argc) )
+		{
+			g_pchEeprom = argv[ ++idx ];
+		}
+		else if( (0 == strcmp( argv[ idx ], "--trace" )) && ((idx + 1) < argc) )
+		{
+			g_pchTrace = argv[ ++idx ];
+		}
+		else
+		{
+			g_pchScenario = argv[ idx ];
+		}
+	}
+
+	if( NULL == g_pchScenario )
+	{
+		fprintf( stderr, "usage: %s <scenario file> [--eeprom <file>] [--trace <file>]\n", argv[ 0 ] );
+		return( 1 );
+	}
+
+	if( !LoadScenario( g_pchScenario ) )
+	{
+		return( 1 );
+	}
+
+	if( !OpenEeprom() )
+	{
+		fprintf( stderr, "can't open EEPROM file '%s'\n", g_pchEeprom );
+		return( 1 );
+	}
+
+	if( NULL != g_pchTrace )
+	{
+		pTraceFile = fopen( g_pchTrace, "wb" );
+
+		if( NULL == pTraceFile )
+		{
+			fprintf( stderr, "can't open trace file '%s'\n", g_pchTrace );
+			return( 1 );
+		}
+
+		SimSerialOpen( pTraceFile );
+	}
+
+	SimSetClock( (uint64_t)g_ulStartTime * 1000 );
+
+	SimAddTickHook( ScenarioTick );
+	SimUpdatePins();
+
+	SimLog( "SETUP" );
+	setup();
+	SimLog( "READY" );
+	CheckOutputs();
+
+	while( !g_bEnd && (g_uiNextEvent < g_uiEventCount) )
+	{
+		loop();
+		ulLoops++;
+
+		SimAdvance( g_ulLoopCost );
+		CheckOutputs();
+	}
+
+	SimLog( "END loops=%u sent=%u", ulLoops, SimBusGetSendCount() );
+
+	if( g_bTempEeprom )
+	{
+		unlink( g_pchEeprom );
+	}
+
+	if( NULL != pTraceFile )
+	{
+		fclose( pTraceFile );
+	}
+
+	return( 0 );
+}
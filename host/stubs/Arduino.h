@@ -0,0 +1,108 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		Arduino.h	(host simulation)
+//#
+//#	Stand-in for the Arduino core when the firmware is compiled for the
+//#	host. Only the parts that are used by the firmware are provided:
+//#		-	millis(), micros(), delay() driven by the virtual clock
+//#		-	port registers (see avr/io.h)
+//#		-	EEPROM access (see avr/eeprom.h)
+//#		-	F() macro for flash strings
+//#		-	USB serial interface 'Serial' (see sim_arduino.cpp)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add the USB serial interface 'Serial'
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <avr/eeprom.h>
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+#define HIGH				0x1
+#define LOW					0x0
+
+#define INPUT				0x0
+#define OUTPUT				0x1
+#define INPUT_PULLUP		0x2
+
+#define F_CPU				16000000UL
+
+
+//----------------------------------------------------------------------
+//	flash strings are plain strings on the host
+//
+class __FlashStringHelper;
+
+#define F( string_literal )	(reinterpret_cast< const __FlashStringHelper * >( string_literal ))
+
+
+//----------------------------------------------------------------------
+//	USB serial interface (CDC) of the ATmega32U4
+//	only the non blocking parts are provided
+//
+class Serial_
+{
+	public:
+		void	begin( uint32_t ulBaudrate );
+		bool	dtr( void );
+		int		availableForWrite( void );
+		size_t	write( const uint8_t *pBuffer, size_t size );
+
+		inline operator bool( void )
+		{
+			return( dtr() );
+		};
+};
+
+extern Serial_	Serial;
+
+
+//==========================================================================
+//
+//		F U N C T I O N   D E C L A R A T I O N
+//
+//==========================================================================
+
+//----------------------------------------------------------------------
+//	on the AVR 'unsigned long' is 32 bit wide, so the virtual clock
+//	uses uint32_t to show the same roll over behaviour
+//
+uint32_t	millis( void );
+uint32_t	micros( void );
+void		delay( uint32_t ulMillis );
+void		delayMicroseconds( uint16_t uiMicros );
@@ -0,0 +1,155 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		LocoNet.h	(host simulation)
+//#
+//#	Stand-in for the LocoNet library. The bus is simulated in process
+//#	(see sim/sim_loconet.cpp):
+//#		-	every sent message is logged and echoed back into the
+//#			receive queue, just as the real bus does
+//#		-	the scenario script injects messages of other devices
+//#
+//#	Switch and sensor messages use the real LocoNet encoding.
+//#	LNCV messages use a simplified encoding that carries the
+//#	parameters of the callback functions directly.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <stdint.h>
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+//----------------------------------------------------------------------
+//	op codes
+//
+#define OPC_SW_REQ				0xB0
+#define OPC_SW_REP				0xB1
+#define OPC_INPUT_REP			0xB2
+#define OPC_SW_STATE			0xBC
+#define OPC_PEER_XFER			0xE5
+
+#define OPC_SW_REQ_OUT			0x10
+#define OPC_SW_REQ_DIR			0x20
+#define OPC_INPUT_REP_HI		0x10
+#define OPC_INPUT_REP_SW		0x20
+#define OPC_INPUT_REP_X			0x40
+
+//----------------------------------------------------------------------
+//	simplified LNCV messages (OPC_PEER_XFER, data[ 2 ])
+//
+#define LNCV_SIM_DISCOVER		0x01
+#define LNCV_SIM_PROG_START		0x02
+#define LNCV_SIM_PROG_STOP		0x03
+#define LNCV_SIM_READ			0x04
+#define LNCV_SIM_WRITE			0x05
+
+//----------------------------------------------------------------------
+//	LNCV acknowledge codes
+//
+#define LNCV_LACK_ERROR_GENERIC			0
+#define LNCV_LACK_ERROR_UNSUPPORTED		1
+#define LNCV_LACK_ERROR_READONLY		2
+#define LNCV_LACK_ERROR_OUTOFRANGE		3
+#define LNCV_LACK_ERROR_UNKNOWN			4
+#define LNCV_LACK_OK					5
+
+
+typedef enum
+{
+	LN_CD_BACKOFF = 0,
+	LN_PRIO_BACKOFF,
+	LN_NETWORK_BUSY,
+	LN_DONE,
+	LN_COLLISION,
+	LN_UNKNOWN_ERROR,
+	LN_RETRY_ERROR
+
+}	LN_STATUS;
+
+
+typedef union
+{
+	uint8_t		data[ 16 ];
+
+}	lnMsg;
+
+
+//==========================================================================
+//
+//		C L A S S   D E F I N I T I O N S
+//
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////
+//	CLASS:	LocoNetClass
+//
+class LocoNetClass
+{
+	public:
+		void		init( uint8_t txPin = 6 );
+		lnMsg *		receive( void );
+		LN_STATUS	send( lnMsg *TxPacket );
+
+		LN_STATUS	requestSwitch( uint16_t Address, uint8_t Output, uint8_t Direction );
+		LN_STATUS	reportSwitch(  uint16_t Address );
+		LN_STATUS	reportSensor(  uint16_t Address, uint8_t State );
+
+		uint8_t		processSwitchSensorMessage( lnMsg *LnPacket );
+};
+
+
+////////////////////////////////////////////////////////////////////////
+//	CLASS:	LocoNetCVClass
+//
+class LocoNetCVClass
+{
+	public:
+		bool processLNCVMessage( lnMsg *LnPacket );
+};
+
+
+//==========================================================================
+//
+//		E X T E R N   G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+extern LocoNetClass		LocoNet;
+
+
+//==========================================================================
+//
+//		C A L L B A C K   F U N C T I O N S
+//
+//==========================================================================
+
+extern void notifySensor(        uint16_t Address, uint8_t State )						__attribute__(( weak ));
+extern void notifySwitchRequest( uint16_t Address, uint8_t Output, uint8_t Direction )	__attribute__(( weak ));
+extern void notifySwitchReport(  uint16_t Address, uint8_t Output, uint8_t Direction )	__attribute__(( weak ));
+extern void notifySwitchState(   uint16_t Address, uint8_t Output, uint8_t Direction )	__attribute__(( weak ));
+
+extern int8_t notifyLNCVdiscover(         uint16_t &ArtNr, uint16_t &ModuleAddress )						__attribute__(( weak ));
+extern int8_t notifyLNCVprogrammingStart( uint16_t &ArtNr, uint16_t &ModuleAddress )						__attribute__(( weak ));
+extern void   notifyLNCVprogrammingStop(  uint16_t  ArtNr, uint16_t  ModuleAddress )						__attribute__(( weak ));
+extern int8_t notifyLNCVread(             uint16_t  ArtNr, uint16_t  Address, uint16_t, uint16_t &Value )	__attribute__(( weak ));
+extern int8_t notifyLNCVwrite(            uint16_t  ArtNr, uint16_t  Address, uint16_t  Value )				__attribute__(( weak ));
@@ -0,0 +1,26 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		Wire.h	(host simulation)
+//#
+//#	The I2C bus is not simulated. The OLED display is replaced by a
+//#	character buffer (see simple_oled_sh1106.h).
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <Arduino.h>
@@ -0,0 +1,66 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		avr/eeprom.h	(host simulation)
+//#
+//#	The 1 KByte EEPROM of the ATmega32U4 is kept in memory and
+//#	mirrored into a file, so the configuration survives between
+//#	two simulation runs (see sim/sim_arduino.cpp).
+//#	Like on the chip a write only starts the programming of the cell,
+//#	the next access waits until the EEPROM is ready again.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the EEPROM is busy for 3.3 ms after a write
+//#		-	eeprom_update_byte(), eeprom_is_ready()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+#define E2END		0x3FF
+
+
+//==========================================================================
+//
+//		F U N C T I O N   D E C L A R A T I O N
+//
+//==========================================================================
+
+uint8_t		eeprom_read_byte(  const uint8_t  *puAddress );
+uint16_t	eeprom_read_word(  const uint16_t *puiAddress );
+void		eeprom_read_block( void *pDest, const void *pSource, size_t size );
+
+void		eeprom_write_byte(  uint8_t  *puAddress,  uint8_t  usValue );
+void		eeprom_write_word(  uint16_t *puiAddress, uint16_t uiValue );
+void		eeprom_update_byte( uint8_t  *puAddress,  uint8_t  usValue );
+void		eeprom_update_word( uint16_t *puiAddress, uint16_t uiValue );
+
+bool		eeprom_is_ready( void );
+void		eeprom_busy_wait( void );
@@ -0,0 +1,42 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		avr/interrupt.h	(host simulation)
+//#
+//#	The global interrupt flag is kept in bit 7 of the simulated SREG.
+//#	Interrupt service routines become plain functions with C linkage,
+//#	the simulator calls them when the virtual clock passes the
+//#	respective event.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <avr/io.h>
+
+
+//==========================================================================
+//
+//		M A C R O S
+//
+//==========================================================================
+
+#define SREG_I				7
+
+#define cli()				(SREG &= ~_BV( SREG_I ))
+#define sei()				(SREG |=  _BV( SREG_I ))
+
+#define ISR( vector, ... )	extern "C" void vector( void )
@@ -0,0 +1,182 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		avr/io.h	(host simulation)
+//#
+//#	The I/O registers of the ATmega32U4 that are used by the firmware.
+//#	On the host they are plain variables. The simulator updates the
+//#	PINx registers from the PORTx/DDRx registers and the simulated
+//#	external pin levels (see sim/sim_arduino.cpp).
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	5		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	Timer 3 (counter only, no interrupts)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	4		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	EEPROM control register
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	3		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	pin change interrupt 0
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	Timer 0 interrupt mask and compare register B
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <stdint.h>
+
+
+//==========================================================================
+//
+//		M A C R O S
+//
+//==========================================================================
+
+#define _BV( bit )					(1 << (bit))
+#define _SFR_BYTE( sfr )			(sfr)
+
+#define bit_is_set( sfr, bit )		(_SFR_BYTE( sfr ) & _BV( bit ))
+#define bit_is_clear( sfr, bit )	(!(_SFR_BYTE( sfr ) & _BV( bit )))
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+//----------------------------------------------------------------------
+//	port pin numbers (identical for all ports)
+//
+#define PB0		0
+#define PB1		1
+#define PB2		2
+#define PB3		3
+#define PB4		4
+#define PB5		5
+#define PB6		6
+#define PB7		7
+
+#define PC6		6
+#define PC7		7
+
+#define PD0		0
+#define PD1		1
+#define PD2		2
+#define PD3		3
+#define PD4		4
+#define PD5		5
+#define PD6		6
+#define PD7		7
+
+#define PE2		2
+#define PE6		6
+
+#define PF0		0
+#define PF1		1
+#define PF4		4
+#define PF5		5
+#define PF6		6
+#define PF7		7
+
+//----------------------------------------------------------------------
+//	Timer 0
+//
+#define OCIE0A	1
+#define OCIE0B	2
+#define TOIE0	0
+
+//----------------------------------------------------------------------
+//	Timer 3 clock select
+//
+#define CS30	0
+#define CS31	1
+#define CS32	2
+
+//----------------------------------------------------------------------
+//	pin change interrupt 0 (PB0 .. PB7)
+//
+#define PCIE0	0
+#define PCIF0	0
+
+//----------------------------------------------------------------------
+//	EEPROM control register
+//
+#define EERE	0
+#define EEPE	1
+#define EEMPE	2
+#define EERIE	3
+
+
+//==========================================================================
+//
+//		E X T E R N   G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+extern volatile uint8_t		PINB;
+extern volatile uint8_t		DDRB;
+extern volatile uint8_t		PORTB;
+
+extern volatile uint8_t		PINC;
+extern volatile uint8_t		DDRC;
+extern volatile uint8_t		PORTC;
+
+extern volatile uint8_t		PIND;
+extern volatile uint8_t		DDRD;
+extern volatile uint8_t		PORTD;
+
+extern volatile uint8_t		PINE;
+extern volatile uint8_t		DDRE;
+extern volatile uint8_t		PORTE;
+
+extern volatile uint8_t		PINF;
+extern volatile uint8_t		DDRF;
+extern volatile uint8_t		PORTF;
+
+extern volatile uint8_t		SREG;
+
+extern volatile uint8_t		TIMSK0;
+extern volatile uint8_t		OCR0B;
+
+extern volatile uint8_t		TCCR3A;
+extern volatile uint8_t		TCCR3B;
+extern volatile uint8_t		TCCR3C;
+extern volatile uint8_t		TIMSK3;
+extern volatile uint16_t	TCNT3;
+
+extern volatile uint8_t		PCICR;
+extern volatile uint8_t		PCIFR;
+extern volatile uint8_t		PCMSK0;
+
+extern volatile uint8_t		EECR;
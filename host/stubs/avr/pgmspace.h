@@ -0,0 +1,42 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		avr/pgmspace.h	(host simulation)
+//#
+//#	The host has only one address space, so flash data is ordinary
+//#	read-only data and the pgm_read_xxx() functions are plain reads.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <stdint.h>
+
+
+//==========================================================================
+//
+//		M A C R O S
+//
+//==========================================================================
+
+#define PROGMEM
+
+#define PSTR( s )						(s)
+
+#define pgm_read_byte( address )		(*(const uint8_t  *)(address))
+#define pgm_read_word( address )		(*(const uint16_t *)(address))
+#define pgm_read_dword( address )		(*(const uint32_t *)(address))
+#define pgm_read_ptr( address )			(*(void * const *)(address))
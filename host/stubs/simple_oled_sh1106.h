@@ -0,0 +1,84 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		simple_oled_sh1106.h	(host simulation)
+//#
+//#	The OLED display is replaced by a buffer of 8 lines with
+//#	16 characters each. The simulator can print the buffer
+//#	(see sim/sim_display.cpp).
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <Arduino.h>
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+#define OLED_LINES			8
+#define OLED_COLUMNS		16
+
+
+//==========================================================================
+//
+//		C L A S S   D E F I N I T I O N S
+//
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////
+//	CLASS:	SimpleOledClass
+//
+class SimpleOledClass
+{
+	public:
+		SimpleOledClass();
+
+		void Init( void );
+		void Flip( bool bFlip );
+		void Clear( void );
+		void ClearLine( uint8_t usLine );
+		void SetCursor( uint8_t usLine, uint8_t usColumn );
+		void SetInverseFont( bool bInverse );
+
+		void Print( const char *pchText );
+		void Print( const __FlashStringHelper *pText );
+
+		//----------------------------------------------------------
+		//	simulation only
+		//
+		void		Dump( FILE *pFile );
+		uint32_t	GetWriteCount( void );
+
+	private:
+		char		m_arScreen[ OLED_LINES ][ OLED_COLUMNS + 1 ];
+		uint8_t		m_usLine;
+		uint8_t		m_usColumn;
+		uint32_t	m_ulWriteCount;
+};
+
+
+//==========================================================================
+//
+//		E X T E R N   G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+extern SimpleOledClass	g_clDisplay;
@@ -0,0 +1,58 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		util/crc16.h	(host simulation)
+//#
+//#	The CRC functions of avr-libc are written in assembler, here
+//#	they are the C equivalents from the avr-libc documentation.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#			_crc16_update()
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <stdint.h>
+
+
+//==========================================================================
+//
+//		I N L I N E   F U N C T I O N S
+//
+//==========================================================================
+
+//**********************************************************************
+//	_crc16_update
+//----------------------------------------------------------------------
+//	CRC-16 (polynomial x^16 + x^15 + x^2 + 1, 0xA001)
+//
+static inline uint16_t _crc16_update( uint16_t uiCrc, uint8_t usData )
+{
+	uiCrc ^= usData;
+
+	for( uint8_t idx = 0 ; idx < 8 ; idx++ )
+	{
+		if( uiCrc & 1 )
+		{
+			uiCrc = (uiCrc >> 1) ^ 0xA001;
+		}
+		else
+		{
+			uiCrc = (uiCrc >> 1);
+		}
+	}
+
+	return( uiCrc );
+}
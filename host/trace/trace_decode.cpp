@@ -0,0 +1,253 @@
+//##########################################################################
+//#
+//#		Decoder of the USB trace
+//#
+//#	Prints the binary trace records of the firmware (compile option
+//#	USB_TRACE, see usb_trace.h) as text, one line per record.
+//#
+//#	Usage:
+//#		fremo_uni_io_trace [<file>]
+//#	Without a file the records are read from stdin, e.g. from the
+//#	USB serial interface of the board:
+//#		stty -F /dev/ttyACM0 raw
+//#		fremo_uni_io_trace /dev/ttyACM0
+//#	or from the trace file of the simulation:
+//#		fremo_uni_io_sim <scenario file> --trace trace.bin
+//#		fremo_uni_io_trace trace.bin
+//#
+//#	Output, the time in seconds (the 16 bit time of the records is
+//#	continued over its wrap around):
+//#		<s>.<ms>  START    version=<n>
+//#		<s>.<ms>  INPUT    changed=<mask> state=<mask>
+//#		<s>.<ms>  LN_RX    sensor|switch adr=<n> dir=<0|1> [matched] [echo]
+//#		<s>.<ms>  LN_TX    sensor|switch adr=<n> dir=<0|1> [failed]
+//#		<s>.<ms>  LNCV     read|write lncv=<n> value=<n>
+//#		<s>.<ms>  LNCV     start|stop art=<n> module=<n>
+//#		<s>.<ms>  LOOP     max=<us> loops=<n>
+//#		<s>.<ms>  DROPPED  total=<n>
+//#	Bytes that do not belong to a valid record are skipped, the
+//#	decoder synchronises on the next record with a valid check sum.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "usb_trace.h"
+
+
+//==========================================================================
+//
+//		G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+static uint32_t		g_ulTime		= 0;
+static uint16_t		g_uiLastTime	= 0;
+static bool			g_bTimeValid	= false;
+
+
+//==========================================================================
+//
+//		F U N C T I O N S
+//
+//==========================================================================
+
+//**************************************************************************
+//	IsRecord
+//--------------------------------------------------------------------------
+//	checks sync byte and check sum
+//
+static bool IsRecord( const uint8_t *pRecord )
+{
+	uint8_t	usCheck	= 0;
+
+	if( TRACE_SYNC != (pRecord[ 0 ] & TRACE_SYNC_MASK) )
+	{
+		return( false );
+	}
+
+	for( uint8_t idx = 0 ; idx < (TRACE_RECORD_SIZE - 1) ; idx++ )
+	{
+		usCheck ^= pRecord[ idx ];
+	}
+
+	return( usCheck == pRecord[ TRACE_RECORD_SIZE - 1 ] );
+}
+
+
+//**************************************************************************
+//	PrintLoconet
+//--------------------------------------------------------------------------
+//
+static void PrintLoconet( const char *pchName, uint16_t uiAddress, uint16_t uiFlags )
+{
+	printf(	"%-8s %s adr=%u dir=%u%s%s%s\n", pchName,
+			(uiFlags & TRACE_FLAG_SENSOR) ? "sensor" : "switch",
+			uiAddress, (uiFlags & TRACE_FLAG_DIR) ? 1 : 0,
+			(uiFlags & TRACE_FLAG_MATCHED) ? " matched" : "",
+			(uiFlags & TRACE_FLAG_ECHO) ? " echo" : "",
+			(uiFlags & TRACE_FLAG_FAILED) ? " failed" : ""			);
+}
+
+
+//**************************************************************************
+//	PrintRecord
+//--------------------------------------------------------------------------
+//
+static void PrintRecord( const uint8_t *pRecord )
+{
+	uint8_t		usType		= pRecord[ 0 ] & TRACE_TYPE_MASK;
+	uint16_t	uiTime		= pRecord[ 1 ] | (pRecord[ 2 ] << 8);
+	uint16_t	uiValueA	= pRecord[ 3 ] | (pRecord[ 4 ] << 8);
+	uint16_t	uiValueB	= pRecord[ 5 ] | (pRecord[ 6 ] << 8);
+
+	//----------------------------------------------------------------
+	//	after a start the board counts from 0 again
+	//
+	if( !g_bTimeValid || (TRACE_TYPE_START == usType) )
+	{
+		g_ulTime		= uiTime;
+		g_bTimeValid	= true;
+	}
+	else
+	{
+		g_ulTime += (uint16_t)(uiTime - g_uiLastTime);
+	}
+
+	g_uiLastTime = uiTime;
+
+	printf( "%6u.%03u  ", g_ulTime / 1000, g_ulTime % 1000 );
+
+	switch( usType )
+	{
+		case TRACE_TYPE_START:
+			printf( "%-8s version=%u\n", "START", uiValueA );
+			break;
+
+		case TRACE_TYPE_INPUT:
+			printf( "%-8s changed=0x%04X state=0x%04X\n", "INPUT", uiValueA, uiValueB );
+			break;
+
+		case TRACE_TYPE_LN_RX:
+			PrintLoconet( "LN_RX", uiValueA, uiValueB );
+			break;
+
+		case TRACE_TYPE_LN_TX:
+			PrintLoconet( "LN_TX", uiValueA, uiValueB );
+			break;
+
+		case TRACE_TYPE_LNCV_READ:
+			printf( "%-8s read lncv=%u value=%u\n", "LNCV", uiValueA, uiValueB );
+			break;
+
+		case TRACE_TYPE_LNCV_WRITE:
+			printf( "%-8s write lncv=%u value=%u\n", "LNCV", uiValueA, uiValueB );
+			break;
+
+		case TRACE_TYPE_LNCV_START:
+			printf( "%-8s start art=%u module=%u\n", "LNCV", uiValueA, uiValueB );
+			break;
+
+		case TRACE_TYPE_LNCV_STOP:
+			printf( "%-8s stop art=%u module=%u\n", "LNCV", uiValueA, uiValueB );
+			break;
+
+		case TRACE_TYPE_LOOP:
+			printf( "%-8s max=%uus loops=%u\n", "LOOP", uiValueA, uiValueB );
+			break;
+
+		case TRACE_TYPE_DROPPED:
+			printf( "%-8s total=%u\n", "DROPPED", uiValueA );
+			break;
+
+		default:
+			printf( "%-8s type=%u a=%u b=%u\n", "UNKNOWN", usType, uiValueA, uiValueB );
+			break;
+	}
+}
+
+
+//**************************************************************************
+//	main
+//--------------------------------------------------------------------------
+//
+int main( int argc, char *argv[] )
+{
+	FILE *		pFile		= stdin;
+	uint8_t		arRecord[ TRACE_RECORD_SIZE ];
+	uint8_t		usFill		= 0;
+	uint32_t	ulRecords	= 0;
+	uint32_t	ulSkipped	= 0;
+	int			iByte;
+
+	if( 2 < argc )
+	{
+		fprintf( stderr, "usage: %s [<file>]\n", argv[ 0 ] );
+		return( 1 );
+	}
+
+	if( 2 == argc )
+	{
+		pFile = fopen( argv[ 1 ], "rb" );
+
+		if( NULL == pFile )
+		{
+			fprintf( stderr, "can't open trace file '%s'\n", argv[ 1 ] );
+			return( 1 );
+		}
+	}
+
+	//----	each record at once, when reading from the board  ---------
+	setvbuf( stdout, NULL, _IOLBF, 0 );
+
+	while( EOF != (iByte = fgetc( pFile )) )
+	{
+		arRecord[ usFill++ ] = (uint8_t)iByte;
+
+		if( TRACE_RECORD_SIZE > usFill )
+		{
+			continue;
+		}
+
+		if( IsRecord( arRecord ) )
+		{
+			PrintRecord( arRecord );
+
+			ulRecords++;
+			usFill = 0;
+		}
+		else
+		{
+			//----	out of sync: drop the first byte  ---------------
+			memmove( arRecord, arRecord + 1, TRACE_RECORD_SIZE - 1 );
+
+			ulSkipped++;
+			usFill--;
+		}
+	}
+
+	fprintf( stderr, "%u records, %u bytes skipped\n", ulRecords, ulSkipped );
+
+	if( stdin != pFile )
+	{
+		fclose( pFile );
+	}
+
+	return( 0 );
+}
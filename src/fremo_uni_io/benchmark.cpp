@@ -0,0 +1,374 @@
+//##########################################################################
+//#
+//#		BenchmarkClass
+//#
+//#	This class measures the CPU cycles of the functions that are
+//#	called in each pass of 'loop()'.
+//#	Each function is called BENCH_CALLS times with one of the patterns
+//#		idle	the state does not change
+//#		one		one bit toggles with each call
+//#		all		all bits toggle with each call
+//#	The cycles of an empty call are measured first and will be
+//#	subtracted from the results.
+//#
+//#	Output format (one line for each function and pattern):
+//#		{"target":"avr","version":10502,"bench":"CheckIOState",
+//#		 "pattern":"one","calls":256,"cycles_min":..,"cycles_avg":..,
+//#		 "cycles_max":..,"ns_per_call":..}
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	3		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	dry run: the ports of the outputs are not written and
+//#			the messages of the send queue are dropped instead
+//#			of being sent to the Loconet
+//#		-	off delay timers started by the benchmark are stopped
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the debouncer works on all 16 universal pins at once
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include "compile_options.h"
+
+
+#ifdef BENCHMARK_HOT_PATH
+//**************************************************************************
+//**************************************************************************
+
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+#include "cycle_counter.h"
+#include "debounce.h"
+#include "io_control.h"
+#include "my_loconet.h"
+#include "timer_service.h"
+#include "benchmark.h"
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+#define BENCH_CALLS				256
+#define BENCH_BAUDRATE			115200
+
+//----------------------------------------------------------------------
+//	nano seconds per CPU cycle * 2 (16 MHz => 62.5 ns)
+//
+#define BENCH_NS_PER_2_CYCLES	125
+
+
+//==========================================================================
+//
+//		F U N C T I O N   D E C L A R A T I O N
+//
+//==========================================================================
+
+//----	fremo_uni_io.ino  ----------------------------------------------
+extern uint16_t	g_uiLnState;
+extern uint16_t	g_uiIOState;
+
+uint16_t	GetIOState( void );
+void		CheckIOState( uint16_t uiNewIOState );
+void		CheckLnState( uint16_t uiNewLnState );
+
+
+//==========================================================================
+//
+//		G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+BenchmarkClass	g_clBenchmark	= BenchmarkClass();
+
+DebounceClass< uint16_t >	g_clBenchDebounce( 0x0000 );
+uint16_t		g_uiBenchSink;
+
+
+//==========================================================================
+//
+//		L O C A L   F U N C T I O N S
+//
+//==========================================================================
+
+//**********************************************************************
+//	functions to measure
+//----------------------------------------------------------------------
+//	all functions get the same parameter list, so they can be
+//	called by the same function pointer
+//
+static void BenchEmpty( uint16_t )
+{
+}
+
+static void BenchGetIOState( uint16_t )
+{
+	g_uiBenchSink = GetIOState();
+}
+
+static void BenchCheckIOState( uint16_t uiState )
+{
+	CheckIOState( uiState );
+}
+
+static void BenchCheckLnState( uint16_t uiState )
+{
+	CheckLnState( uiState );
+}
+
+static void BenchDebounceWork( uint16_t uiState )
+{
+	g_clBenchDebounce.Work( uiState );
+}
+
+
+//**********************************************************************
+//	DrainSendQueue
+//----------------------------------------------------------------------
+//	send all messages stored by 'CheckIOState()' so the queue
+//	will never be full during a measurement
+//
+static void DrainSendQueue( void )
+{
+	while( 0 < g_clMyLoconet.GetSendQueueCount() )
+	{
+		g_clMyLoconet.ProcessSendQueue();
+	}
+}
+
+
+//==========================================================================
+//
+//		C L A S S   F U N C T I O N S
+//
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////
+//	CLASS: BenchmarkClass
+//
+
+//**********************************************************************
+//	Constructor
+//----------------------------------------------------------------------
+//
+BenchmarkClass::BenchmarkClass()
+{
+	m_uiVersion		= 0;
+	m_uiOverhead	= 0;
+}
+
+
+//**********************************************************************
+//	Run
+//----------------------------------------------------------------------
+//	The function waits for the serial monitor, measures all
+//	functions and restores the I/O and Loconet state afterwards.
+//	All is done as dry run, so neither the outputs nor the
+//	Loconet see anything of the benchmark.
+//
+void BenchmarkClass::Run( uint16_t uiVersion )
+{
+	bench_result_t	result;
+	uint16_t		uiIOState	= g_uiIOState;
+	uint16_t		uiLnState	= g_uiLnState;
+	uint16_t		uiTimers	= 0x0000;
+
+	m_uiVersion = uiVersion;
+
+	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
+	{
+		if( g_clTimerService.IsRunning( idx ) )
+		{
+			uiTimers |= ((uint16_t)1) << idx;
+		}
+	}
+
+	DrainSendQueue();
+
+	g_clControl.SetDryRun( true );
+	g_clMyLoconet.SetDryRun( true );
+
+	Serial.begin( BENCH_BAUDRATE );
+
+	while( !Serial )
+	{
+		;
+	}
+
+	CycleCounterInit();
+
+	//--------------------------------------------------------------
+	//	costs of the measurement itself
+	//
+	m_uiOverhead = 0;
+	Measure( BenchEmpty, 0x0000, 0x0000, &result );
+	m_uiOverhead = result.uiMin;
+
+	Report( "GetIOState",	0x0000,		0x0000, BenchGetIOState );
+
+	Report( "CheckIOState",	uiIOState,	0x0000, BenchCheckIOState );
+	Report( "CheckIOState",	uiIOState,	0x0001, BenchCheckIOState );
+	Report( "CheckIOState",	uiIOState,	0xFFFF, BenchCheckIOState );
+
+	Report( "CheckLnState",	uiLnState,	0x0000, BenchCheckLnState );
+	Report( "CheckLnState",	uiLnState,	0x0001, BenchCheckLnState );
+	Report( "CheckLnState",	uiLnState,	0xFFFF, BenchCheckLnState );
+
+	Report( "DebounceWork",	0xFFFF,		0x0000, BenchDebounceWork );
+	Report( "DebounceWork",	0xFFFF,		0x0001, BenchDebounceWork );
+	Report( "DebounceWork",	0xFFFF,		0xFFFF, BenchDebounceWork );
+
+	//--------------------------------------------------------------
+	//	back to the state before the benchmark
+	//
+	CheckIOState( uiIOState );
+	CheckLnState( uiLnState );
+	DrainSendQueue();
+
+	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
+	{
+		if( !(uiTimers & (((uint16_t)1) << idx)) )
+		{
+			g_clTimerService.Stop( idx );
+		}
+	}
+
+	g_clControl.SetDryRun( false );
+	g_clMyLoconet.SetDryRun( false );
+}
+
+
+//**********************************************************************
+//	Measure
+//----------------------------------------------------------------------
+//	Calls the function BENCH_CALLS times. The state for the call
+//	is 'uiBase' for even calls and 'uiBase ^ uiToggle' for odd calls.
+//	The interrupts are blocked during each call.
+//
+void BenchmarkClass::Measure(	bench_func_t pFunc, uint16_t uiBase,
+								uint16_t uiToggle, bench_result_t *pResult	)
+{
+	uint16_t	uiStart;
+	uint16_t	uiCycles;
+	uint8_t		usSREG;
+
+	pResult->uiMin	= 0xFFFF;
+	pResult->uiMax	= 0x0000;
+	pResult->ulSum	= 0L;
+
+	for( uint16_t idx = 0 ; idx < BENCH_CALLS ; idx++ )
+	{
+		uint16_t	uiState = (idx & 0x0001) ? (uiBase ^ uiToggle) : uiBase;
+
+		usSREG = SREG;
+		cli();
+
+		uiStart = CycleCounterRead();
+		(*pFunc)( uiState );
+		uiCycles = CycleCounterRead() - uiStart;
+
+		SREG = usSREG;
+
+		DrainSendQueue();
+
+		if( uiCycles > m_uiOverhead )
+		{
+			uiCycles -= m_uiOverhead;
+		}
+		else
+		{
+			uiCycles = 0;
+		}
+
+		if( uiCycles < pResult->uiMin )
+		{
+			pResult->uiMin = uiCycles;
+		}
+
+		if( uiCycles > pResult->uiMax )
+		{
+			pResult->uiMax = uiCycles;
+		}
+
+		pResult->ulSum += uiCycles;
+	}
+
+	//--------------------------------------------------------------
+	//	end with the base state
+	//
+	(*pFunc)( uiBase );
+	DrainSendQueue();
+}
+
+
+//**********************************************************************
+//	Report
+//----------------------------------------------------------------------
+//	measures one function with one pattern and prints the result
+//
+void BenchmarkClass::Report(	const char *pchBench, uint16_t uiBase,
+								uint16_t uiToggle, bench_func_t pFunc	)
+{
+	bench_result_t	result;
+	char			chLine[ 200 ];
+	const char *	pchPattern;
+	uint32_t		ulAverage;
+
+	if( 0x0000 == uiToggle )
+	{
+		pchPattern = "idle";
+	}
+	else if( 0x0000 == (uiToggle & (uiToggle - 1)) )
+	{
+		pchPattern = "one";
+	}
+	else
+	{
+		pchPattern = "all";
+	}
+
+	Measure( pFunc, uiBase, uiToggle, &result );
+
+	ulAverage = result.ulSum / BENCH_CALLS;
+
+	sprintf_P(	chLine,
+				PSTR(	"{\"target\":\"avr\",\"version\":%u,\"bench\":\"%s\","
+						"\"pattern\":\"%s\",\"calls\":%u,\"cycles_min\":%u,"
+						"\"cycles_avg\":%lu,\"cycles_max\":%u,\"ns_per_call\":%lu}" ),
+				m_uiVersion, pchBench, pchPattern, BENCH_CALLS,
+				result.uiMin, ulAverage, result.uiMax,
+				(ulAverage * BENCH_NS_PER_2_CYCLES) / 2							);
+
+	Serial.println( chLine );
+}
+
+
+//**************************************************************************
+//**************************************************************************
+#endif	//	BENCHMARK_HOT_PATH
@@ -0,0 +1,101 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		BenchmarkClass
+//#
+//#	This class measures the functions that are called in each pass
+//#	of 'loop()':
+//#		-	GetIOState()
+//#		-	CheckIOState()
+//#		-	CheckLnState()
+//#		-	DebounceClass::Work()
+//#	The CPU cycles are counted with Timer 3 (see cycle_counter.h).
+//#	The results are sent over the USB serial interface, one JSON
+//#	object per line, so they can be compared between versions.
+//#
+//#	The benchmark runs as a dry run: the outputs are not switched
+//#	and no Loconet message is sent (see 'SetDryRun()' of
+//#	IO_ControlClass and MyLoconetClass). Off delay timers started
+//#	by the benchmark are stopped at the end.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	dry run, the benchmark no longer switches the outputs
+//#			and sends no Loconet messages
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <stdint.h>
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+typedef void (*bench_func_t)( uint16_t uiState );
+
+
+typedef struct bench_result
+{
+	uint16_t	uiMin;
+	uint16_t	uiMax;
+	uint32_t	ulSum;
+
+}	bench_result_t;
+
+
+//==========================================================================
+//
+//		C L A S S   D E F I N I T I O N S
+//
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////
+//	CLASS:	BenchmarkClass
+//
+class BenchmarkClass
+{
+	public:
+		BenchmarkClass();
+
+		void Run( uint16_t uiVersion );
+
+	private:
+		uint16_t	m_uiVersion;
+		uint16_t	m_uiOverhead;
+
+		void Measure(	bench_func_t pFunc, uint16_t uiBase,
+						uint16_t uiToggle, bench_result_t *pResult	);
+		void Report(	const char *pchBench, uint16_t uiBase,
+						uint16_t uiToggle, bench_func_t pFunc		);
+};
+
+
+//==========================================================================
+//
+//		E X T E R N   G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+extern BenchmarkClass	g_clBenchmark;
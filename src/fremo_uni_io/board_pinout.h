@@ -0,0 +1,275 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		board_pinout.h
+//#
+//#	This file describes the pinout of the boards at compile time.
+//#	Each pin is coded in one byte:
+//#		bit 7..3	port (PORT_ID_B .. PORT_ID_F)
+//#		bit 2..0	pin of port
+//#
+//#	For each board version there is a specialization of the template
+//#	'BoardPinout' with
+//#		PinCode( n )	code of the universal pin n (IO pin)
+//#		LedGreen		code of the green LED
+//#		LedRed			code of the red LED
+//#		Relais			code of the relais (PIN_CODE_NONE if missing)
+//#	A new board version only needs a new specialization.
+//#	All tables that depend on the pinout are derived from these
+//#	definitions at compile time.
+//#
+//#	With a constant pin code the functions PinHigh(), PinLow() and
+//#	PinIsHigh() compile to a single sbi, cbi or sbis instruction.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#			the tables were moved from io_control.cpp to here
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include "compile_options.h"
+
+#include <avr/io.h>
+#include <stdint.h>
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+#define PORT_ID_B				0
+#define PORT_ID_C				1
+#define PORT_ID_D				2
+#define PORT_ID_E				3
+#define PORT_ID_F				4
+#define PORT_ID_COUNT			5
+
+#define PIN_CODE( port, bit )	((uint8_t)(((port) << 3) | (bit)))
+#define PIN_CODE_PORT( code )	((uint8_t)((code) >> 3))
+#define PIN_CODE_BIT( code )	((uint8_t)((code) & 0x07))
+#define PIN_CODE_MASK( code )	((uint8_t)(1 << PIN_CODE_BIT( code )))
+#define PIN_CODE_NONE			0xFF
+
+
+//==========================================================================
+//
+//		B O A R D   D E F I N I T I O N S
+//
+//==========================================================================
+
+template< uint8_t usVersion >
+struct BoardPinout;
+
+
+//----------------------------------------------------------------------
+//	Board version 1
+//
+//		Head	Pin		IO Pin	Port Pin
+//		SV 6	6		15			PF 0
+//		SV 6	5		14			PF 1
+//		SV 7	6		13			PF 4
+//		SV 7	5		12			PF 5
+//		SV 8	6		11			PF 6
+//		SV 8	5		10			PF 7
+//		SV 1	6		 9			PB 5
+//		SV 1	5		 8			PB 6
+//		SV 3	6		 7			PC 6
+//		SV 3	5		 6			PC 7
+//		SV 5	6		 5			PE 2
+//		SV 5	5		 4			PB 4
+//		SV 2	6		 3			PB 7
+//		SV 2	5		 2			PD 7
+//		SV 4	6		 1			PD 5
+//		SV 4	5		 0			PD 6
+//
+//		LED GREEN	PB 0
+//		LED RED		PB 1
+//
+template<>
+struct BoardPinout< 1 >
+{
+	static constexpr uint8_t PinCode( uint8_t usIOPin )
+	{
+		return(		( 0 == usIOPin) ? PIN_CODE( PORT_ID_D, 6 )
+				:	( 1 == usIOPin) ? PIN_CODE( PORT_ID_D, 5 )
+				:	( 2 == usIOPin) ? PIN_CODE( PORT_ID_D, 7 )
+				:	( 3 == usIOPin) ? PIN_CODE( PORT_ID_B, 7 )
+				:	( 4 == usIOPin) ? PIN_CODE( PORT_ID_B, 4 )
+				:	( 5 == usIOPin) ? PIN_CODE( PORT_ID_E, 2 )
+				:	( 6 == usIOPin) ? PIN_CODE( PORT_ID_C, 7 )
+				:	( 7 == usIOPin) ? PIN_CODE( PORT_ID_C, 6 )
+				:	( 8 == usIOPin) ? PIN_CODE( PORT_ID_B, 6 )
+				:	( 9 == usIOPin) ? PIN_CODE( PORT_ID_B, 5 )
+				:	(10 == usIOPin) ? PIN_CODE( PORT_ID_F, 7 )
+				:	(11 == usIOPin) ? PIN_CODE( PORT_ID_F, 6 )
+				:	(12 == usIOPin) ? PIN_CODE( PORT_ID_F, 5 )
+				:	(13 == usIOPin) ? PIN_CODE( PORT_ID_F, 4 )
+				:	(14 == usIOPin) ? PIN_CODE( PORT_ID_F, 1 )
+				:	(15 == usIOPin) ? PIN_CODE( PORT_ID_F, 0 )
+				:	PIN_CODE_NONE									);
+	}
+
+	static constexpr uint8_t	LedGreen	= PIN_CODE( PORT_ID_B, 0 );
+	static constexpr uint8_t	LedRed		= PIN_CODE( PORT_ID_B, 1 );
+	static constexpr uint8_t	Relais		= PIN_CODE_NONE;
+};
+
+
+//----------------------------------------------------------------------
+//	Board version 2
+//	same I/O pins as version 1
+//
+//		RELAIS		PB 0
+//		LED RED		PB 1
+//		LED GREEN	PB 2
+//
+template<>
+struct BoardPinout< 2 > : public BoardPinout< 1 >
+{
+	static constexpr uint8_t	LedGreen	= PIN_CODE( PORT_ID_B, 2 );
+	static constexpr uint8_t	LedRed		= PIN_CODE( PORT_ID_B, 1 );
+	static constexpr uint8_t	Relais		= PIN_CODE( PORT_ID_B, 0 );
+};
+
+
+//----------------------------------------------------------------------
+//	the board this firmware is compiled for
+//
+typedef BoardPinout< PLATINE_VERSION >	Board;
+
+
+//**********************************************************************
+//	IsIOPinCode
+//----------------------------------------------------------------------
+//	returns true if the pin code is used by one of the universal pins
+//	(for compile time checks of the board definitions)
+//
+constexpr bool IsIOPinCode( uint8_t usPinCode, uint8_t usIOPin = 0 )
+{
+	return(		(PIN_CODE_NONE == Board::PinCode( usIOPin ))	? false
+			:	(usPinCode == Board::PinCode( usIOPin ))		? true
+			:	IsIOPinCode( usPinCode, usIOPin + 1 )					);
+}
+
+
+//**********************************************************************
+//	PortToIOBits
+//----------------------------------------------------------------------
+//	returns the universal pin bits (bit n = IO pin n) for the given
+//	value of the port with the ID 'usPortId'
+//	(for tables that are built at compile time)
+//
+constexpr uint16_t PortToIOBits( uint8_t usPortId, uint8_t usPortValue, uint8_t usIOPin = 0 )
+{
+	return(		(PIN_CODE_NONE == Board::PinCode( usIOPin ))	? 0x0000
+			:	(		(usPortId == PIN_CODE_PORT( Board::PinCode( usIOPin ) ))
+					&&	(usPortValue & PIN_CODE_MASK( Board::PinCode( usIOPin ) )))
+				?	(uint16_t)((1u << usIOPin) | PortToIOBits( usPortId, usPortValue, usIOPin + 1 ))
+				:	PortToIOBits( usPortId, usPortValue, usIOPin + 1 )						);
+}
+
+
+//**********************************************************************
+//	IOToPortBits
+//----------------------------------------------------------------------
+//	the other way round: returns the bits of the port with the ID
+//	'usPortId' for the given universal pin bits
+//
+constexpr uint8_t IOToPortBits( uint8_t usPortId, uint16_t uiIOValue, uint8_t usIOPin = 0 )
+{
+	return(		(PIN_CODE_NONE == Board::PinCode( usIOPin ))	? 0x00
+			:	(		(usPortId == PIN_CODE_PORT( Board::PinCode( usIOPin ) ))
+					&&	(uiIOValue & (1u << usIOPin)))
+				?	(uint8_t)(PIN_CODE_MASK( Board::PinCode( usIOPin ) ) | IOToPortBits( usPortId, uiIOValue, usIOPin + 1 ))
+				:	IOToPortBits( usPortId, uiIOValue, usIOPin + 1 )							);
+}
+
+
+//==========================================================================
+//
+//		I N L I N E   F U N C T I O N S
+//
+//==========================================================================
+
+//**********************************************************************
+//	PortRegister / DdrRegister / PinRegister
+//----------------------------------------------------------------------
+//	return the register of the port with the given ID.
+//	With a constant ID the switch is resolved by the compiler.
+//
+static inline __attribute__(( always_inline ))
+volatile uint8_t & PortRegister( uint8_t usPortId )
+{
+	switch( usPortId )
+	{
+		case PORT_ID_B:		return( PORTB );
+		case PORT_ID_C:		return( PORTC );
+		case PORT_ID_D:		return( PORTD );
+		case PORT_ID_E:		return( PORTE );
+		default:			return( PORTF );
+	}
+}
+
+static inline __attribute__(( always_inline ))
+volatile uint8_t & DdrRegister( uint8_t usPortId )
+{
+	switch( usPortId )
+	{
+		case PORT_ID_B:		return( DDRB );
+		case PORT_ID_C:		return( DDRC );
+		case PORT_ID_D:		return( DDRD );
+		case PORT_ID_E:		return( DDRE );
+		default:			return( DDRF );
+	}
+}
+
+static inline __attribute__(( always_inline ))
+volatile uint8_t & PinRegister( uint8_t usPortId )
+{
+	switch( usPortId )
+	{
+		case PORT_ID_B:		return( PINB );
+		case PORT_ID_C:		return( PINC );
+		case PORT_ID_D:		return( PIND );
+		case PORT_ID_E:		return( PINE );
+		default:			return( PINF );
+	}
+}
+
+
+//**********************************************************************
+//	PinHigh / PinLow / PinIsHigh
+//----------------------------------------------------------------------
+//	access to a single pin by its code
+//
+static inline __attribute__(( always_inline ))
+void PinHigh( uint8_t usPinCode )
+{
+	PortRegister( PIN_CODE_PORT( usPinCode ) ) |= PIN_CODE_MASK( usPinCode );
+}
+
+static inline __attribute__(( always_inline ))
+void PinLow( uint8_t usPinCode )
+{
+	PortRegister( PIN_CODE_PORT( usPinCode ) ) &= ~PIN_CODE_MASK( usPinCode );
+}
+
+static inline __attribute__(( always_inline ))
+bool PinIsHigh( uint8_t usPinCode )
+{
+	return( 0 != (PinRegister( PIN_CODE_PORT( usPinCode ) ) & PIN_CODE_MASK( usPinCode )) );
+}
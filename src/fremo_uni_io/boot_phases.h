@@ -0,0 +1,63 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		boot_phases.h
+//#
+//#	The start up ('setup()') is divided into phases. At the end of
+//#	each phase the time (millis()) is kept in 'g_aruiBootTime[]',
+//#	so the start up time can be read afterwards:
+//#		BOOT_PHASE_EEPROM	LNCVs read, checked and written
+//#		BOOT_PHASE_CONFIG	LNCVs decoded
+//#		BOOT_PHASE_INPUTS	ports configured, inputs stable
+//#		BOOT_PHASE_READY	outputs set, the inputs are reported
+//#							in the time slot of the board
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the inputs are no longer sent at the end of 'setup()'
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <stdint.h>
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+#define BOOT_PHASE_EEPROM		0
+#define BOOT_PHASE_CONFIG		1
+#define BOOT_PHASE_INPUTS		2
+#define BOOT_PHASE_READY		3
+#define BOOT_PHASE_COUNT		4
+
+#define BOOT_PHASE( phase )		g_aruiBootTime[ (phase) ] = (uint16_t)millis()
+
+
+//==========================================================================
+//
+//		E X T E R N   G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+extern uint16_t	g_aruiBootTime[ BOOT_PHASE_COUNT ];
@@ -13,12 +13,87 @@
 //#			defines for which board version the software will be compiled.
 //#			(differences in the I/O assignment)
 //#
+//#		-	BENCHMARK_HOT_PATH
+//#			If defined, the functions called in each pass of 'loop()'
+//#			are measured at the end of 'setup()' and the results are
+//#			sent over the USB serial interface (see benchmark.cpp)
+//#			It is a dry run: no output is switched and no Loconet
+//#			message is sent.
+//#
+//#		-	INPUT_EDGE_CAPTURE
+//#			If defined, the edges of the inputs on PB4 .. PB7 are caught
+//#			by the pin change interrupt. An input is taken over as soon
+//#			as no edge was seen for EDGE_SETTLE_TIME ms (io_control.h)
+//#			and the off delay is counted from the time of the edge.
+//#
+//#		-	FAST_BOOT
+//#			If defined, 'setup()' does not wait fixed times. It waits
+//#			only until the EEPROM is written and the levels of the
+//#			inputs are stable (see 'IO_ControlClass::Init()').
+//#			The time of each start up phase is kept in
+//#			'g_aruiBootTime[]' (see boot_phases.h).
+//#
+//#		-	LOOP_PROFILING
+//#			If defined, the time of each phase of 'loop()' is measured
+//#			with Timer 3. Min, avg, max of each phase and a histogram
+//#			of the loop time are read as LNCVs 120 .. 147
+//#			(see loop_profiler.h).
+//#
+//#		-	USB_TRACE
+//#			If defined, input changes, Loconet messages, LNCV
+//#			programming and the loop time are sent as binary trace
+//#			records over the USB serial interface. Records that the
+//#			host does not read are dropped and counted
+//#			(see usb_trace.h).
+//#
 //#-------------------------------------------------------------------------
 //#
 //#		Platine Version 1:	ATmega 32U4, 16 MHz (z.B.: Leonardo)
 //#
 //#-------------------------------------------------------------------------
 //#
+//#	File version:	7		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	BENCHMARK_HOT_PATH is a dry run
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	6		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add compile option USB_TRACE
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	5		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add compile option LOOP_PROFILING
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	4		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add compile option FAST_BOOT
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	3		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add compile option INPUT_EDGE_CAPTURE
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add compile option BENCHMARK_HOT_PATH
+//#
+//#-------------------------------------------------------------------------
+//#
 //#	File version:	1		vom: 27.01.2023
 //#
 //#	Implementation:
@@ -34,5 +109,10 @@
 //==========================================================================
 
 #define DEBUGGING_PRINTOUT
+//#define BENCHMARK_HOT_PATH
+//#define INPUT_EDGE_CAPTURE
+//#define FAST_BOOT
+//#define LOOP_PROFILING
+//#define USB_TRACE
 
 #define PLATINE_VERSION			1
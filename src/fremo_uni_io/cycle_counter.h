@@ -0,0 +1,85 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		cycle_counter.h
+//#
+//#	Cycle counter based on Timer 3 of the ATmega 32U4.
+//#	The timer runs without prescaler, so one count is one CPU cycle
+//#	(62.5 ns at 16 MHz). The counter wraps after 65536 cycles (4 ms),
+//#	so only code parts that take less time can be measured.
+//#
+//#	Timer 3 is not used by the Arduino core or the LocoNet library
+//#	on the Leonardo.
+//#
+//#	For longer code parts the timer can run with the prescaler 64
+//#	(4 us per count, wraps after 262 ms).
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	clock of the timer as parameter of 'CycleCounterInit()'
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <avr/io.h>
+#include <stdint.h>
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+#define CYCLE_COUNTER_CLOCK_1		_BV( CS30 )					//	62.5 ns
+#define CYCLE_COUNTER_CLOCK_64		(_BV( CS31 ) | _BV( CS30 ))	//	4 us
+
+#define CYCLE_COUNTER_US_CLOCK_64	4
+
+
+//==========================================================================
+//
+//		I N L I N E   F U N C T I O N S
+//
+//==========================================================================
+
+//**********************************************************************
+//	CycleCounterInit
+//----------------------------------------------------------------------
+//	Timer 3 in normal mode, clock = CPU clock / prescaler
+//
+static inline void CycleCounterInit( uint8_t usClock = CYCLE_COUNTER_CLOCK_1 )
+{
+	TCCR3A	= 0x00;
+	TCCR3B	= usClock;
+	TCCR3C	= 0x00;
+	TIMSK3	= 0x00;
+	TCNT3	= 0x0000;
+}
+
+
+//**********************************************************************
+//	CycleCounterRead
+//----------------------------------------------------------------------
+//
+static inline uint16_t CycleCounterRead( void )
+{
+	return( TCNT3 );
+}
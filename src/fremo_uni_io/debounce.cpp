@@ -7,6 +7,31 @@
 //#
 //#-------------------------------------------------------------------------
 //#
+//#	File version:	4	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	three bit vertical counter, the number of samples for
+//#			a press and a release can be set for each key
+//#			new function SetSamples()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	3	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	DebounceClass is a template over the word type
+//#			the class is instantiated at the end of this file
+//#			for uint8_t, uint16_t and uint32_t
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new function Confirm()
+//#
+//#-------------------------------------------------------------------------
+//#
 //#	File version:	1	vom: 14.02.2022
 //#
 //#	Implementation:
@@ -55,17 +80,23 @@
 //		repeatMask	Specifies in a bit mask for which keys the
 //					repeat function will be switched on
 //
-DebounceClass::DebounceClass( uint8_t repeatMask )
+template< typename T >
+DebounceClass< T >::DebounceClass( T repeatMask )
 {
-	m_usRepeatMask		= repeatMask;
+	m_tRepeatMask		= repeatMask;
 
-	m_usKeyState		= 0;
-	m_usKeyPress		= 0;
-	m_usKeyRepeat		= 0;
+	m_tKeyState			= 0;
+	m_tKeyPress			= 0;
+	m_tKeyRepeat		= 0;
 
-	m_usDebounce1		= 0xFF;
-	m_usDebounce2		= 0xFF;
 	m_usRepeatCounter	= 0;
+
+	for( uint8_t idx = 0 ; idx < 3 ; idx++ )
+	{
+		m_artCounter[ idx ] = 0;
+	}
+
+	SetSamples( (T)~0, DEBOUNCE_DEFAULT_SAMPLES, DEBOUNCE_DEFAULT_SAMPLES );
 }
 
 //******************************************************************
@@ -76,20 +107,47 @@ DebounceClass::DebounceClass( uint8_t repeatMask )
 //	as often as possible.
 //
 //	Parameter:
-//		keyIn	PIN value of the port that is to be debounced
+//		keyIn	PIN value(s) of the input(s) to be debounced
 //
-void DebounceClass::Work( uint8_t keyIn )
+//	For each key that differs from the debounced state the counter
+//	is incremented, for all other keys it is set to '0'. If the
+//	counter reaches the number of samples for the direction of
+//	the change (press or release), the key changes its state.
+//
+template< typename T >
+void DebounceClass< T >::Work( T keyIn )
 {
-	uint8_t	help	 =	m_usKeyState ^ ~keyIn;
+	T	help	 =	m_tKeyState ^ (T)~keyIn;
+	T	limit0;
+	T	limit1;
+	T	limit2;
+
+	//--------------------------------------------------------------
+	//	increment the vertical counter (three bits)
+	//
+	m_artCounter[ 2 ]	= (m_artCounter[ 2 ] ^ (m_artCounter[ 1 ] & m_artCounter[ 0 ])) & help;
+	m_artCounter[ 1 ]	= (m_artCounter[ 1 ] ^  m_artCounter[ 0 ]) & help;
+	m_artCounter[ 0 ]	= (T)~m_artCounter[ 0 ] & help;
+
+	//--------------------------------------------------------------
+	//	a pressed key can only be released and vice versa
+	//
+	limit0	= (m_tKeyState & m_artRelease[ 0 ]) | (~m_tKeyState & m_artPress[ 0 ]);
+	limit1	= (m_tKeyState & m_artRelease[ 1 ]) | (~m_tKeyState & m_artPress[ 1 ]);
+	limit2	= (m_tKeyState & m_artRelease[ 2 ]) | (~m_tKeyState & m_artPress[ 2 ]);
+
+	help	&= ~(		(m_artCounter[ 0 ] ^ limit0)
+					|	(m_artCounter[ 1 ] ^ limit1)
+					|	(m_artCounter[ 2 ] ^ limit2)	);
 
-	m_usDebounce1	 = ~(m_usDebounce1 & help);
-	m_usDebounce2	 =   m_usDebounce1 ^ (m_usDebounce2 & help);
-	help			&=  (m_usDebounce1 &  m_usDebounce2);
+	m_artCounter[ 0 ]	&= ~help;
+	m_artCounter[ 1 ]	&= ~help;
+	m_artCounter[ 2 ]	&= ~help;
 
-	m_usKeyState	^=  help;
-	m_usKeyPress	|= (m_usKeyState & help);
+	m_tKeyState		^=  help;
+	m_tKeyPress		|= (m_tKeyState & help);
 
-	if( 0 == (m_usKeyState & m_usRepeatMask) )
+	if( 0 == (m_tKeyState & m_tRepeatMask) )
 	{
 		m_usRepeatCounter = REPEAT_START;
 	}
@@ -97,7 +155,84 @@ void DebounceClass::Work( uint8_t keyIn )
 	if( --m_usRepeatCounter == 0 )
 	{
 		m_usRepeatCounter	 = REPEAT_NEXT;
-		m_usKeyRepeat		|= (m_usKeyState & m_usRepeatMask);
+		m_tKeyRepeat		|= (m_tKeyState & m_tRepeatMask);
+	}
+}
+
+
+//******************************************************************
+//	Confirm
+//------------------------------------------------------------------
+//	Takes over the level of the given keys as debounced state.
+//	The counters of these keys are set back to '0',
+//	so Work() will not change them until the level changes again.
+//	A newly pressed key is reported by GetKeyPress() as usual.
+//
+//	Parameter:
+//		key_mask	Specifies in a bit mask which keys should
+//					be taken over
+//		keyIn		PIN value(s) of the input(s)
+//
+template< typename T >
+void DebounceClass< T >::Confirm( T key_mask, T keyIn )
+{
+	T	help	 =	(m_tKeyState ^ (T)~keyIn) & key_mask;
+
+	m_tKeyState		^=	help;
+	m_tKeyPress		|=	(m_tKeyState & help);
+
+	m_artCounter[ 0 ]	&= ~key_mask;
+	m_artCounter[ 1 ]	&= ~key_mask;
+	m_artCounter[ 2 ]	&= ~key_mask;
+}
+
+
+//******************************************************************
+//	SetSamples
+//------------------------------------------------------------------
+//	Sets the number of equal samples that are needed before a key
+//	is reported as pressed resp. as released.
+//	Values out of the range 1 .. DEBOUNCE_MAX_SAMPLES will be
+//	replaced by DEBOUNCE_DEFAULT_SAMPLES.
+//
+//	Parameter:
+//		key_mask	Specifies in a bit mask for which keys the
+//					numbers will be set
+//		usPress		samples needed for a press
+//		usRelease	samples needed for a release
+//
+template< typename T >
+void DebounceClass< T >::SetSamples( T key_mask, uint8_t usPress, uint8_t usRelease )
+{
+	if( (0 == usPress) || (DEBOUNCE_MAX_SAMPLES < usPress) )
+	{
+		usPress = DEBOUNCE_DEFAULT_SAMPLES;
+	}
+
+	if( (0 == usRelease) || (DEBOUNCE_MAX_SAMPLES < usRelease) )
+	{
+		usRelease = DEBOUNCE_DEFAULT_SAMPLES;
+	}
+
+	for( uint8_t idx = 0 ; idx < 3 ; idx++ )
+	{
+		if( usPress & (1 << idx) )
+		{
+			m_artPress[ idx ] |= key_mask;
+		}
+		else
+		{
+			m_artPress[ idx ] &= ~key_mask;
+		}
+
+		if( usRelease & (1 << idx) )
+		{
+			m_artRelease[ idx ] |= key_mask;
+		}
+		else
+		{
+			m_artRelease[ idx ] &= ~key_mask;
+		}
 	}
 }
 
@@ -113,10 +248,11 @@ void DebounceClass::Work( uint8_t keyIn )
 //		key_mask	Specifies in a bit mask which keys should
 //					be checked
 //
-uint8_t DebounceClass::GetKeyPress( uint8_t key_mask )
+template< typename T >
+T DebounceClass< T >::GetKeyPress( T key_mask )
 {
-	key_mask		&=	m_usKeyPress;
-	m_usKeyPress	^=	key_mask;
+	key_mask		&=	m_tKeyPress;
+	m_tKeyPress		^=	key_mask;
 
 	return( key_mask );
 }
@@ -135,10 +271,11 @@ uint8_t DebounceClass::GetKeyPress( uint8_t key_mask )
 //		key_mask	Specifies in a bit mask which keys should
 //					be checked
 //
-uint8_t DebounceClass::GetKeyRepeat( uint8_t key_mask )
+template< typename T >
+T DebounceClass< T >::GetKeyRepeat( T key_mask )
 {
-	key_mask		&=	m_usKeyRepeat;
-	m_usKeyRepeat	^=	key_mask;
+	key_mask		&=	m_tKeyRepeat;
+	m_tKeyRepeat	^=	key_mask;
 
 	return( key_mask );
 }
@@ -154,9 +291,10 @@ uint8_t DebounceClass::GetKeyRepeat( uint8_t key_mask )
 //		key_mask	Specifies in a bit mask which keys should
 //					be checked
 //
-uint8_t DebounceClass::GetKeyState( uint8_t key_mask )
+template< typename T >
+T DebounceClass< T >::GetKeyState( T key_mask )
 {
-	key_mask &= m_usKeyState;
+	key_mask &= m_tKeyState;
 
 	return( key_mask );
 }
@@ -173,9 +311,10 @@ uint8_t DebounceClass::GetKeyState( uint8_t key_mask )
 //		key_mask	Specifies in a bit mask which keys should
 //					be checked
 //
-uint8_t DebounceClass::GetKeyShort( uint8_t key_mask )
+template< typename T >
+T DebounceClass< T >::GetKeyShort( T key_mask )
 {
-	return( GetKeyPress( ~m_usKeyState & key_mask ) );
+	return( GetKeyPress( ~m_tKeyState & key_mask ) );
 }
 
 
@@ -190,7 +329,19 @@ uint8_t DebounceClass::GetKeyShort( uint8_t key_mask )
 //		key_mask	Specifies in a bit mask which keys should
 //					be checked
 //
-uint8_t DebounceClass::GetKeyLong( uint8_t key_mask )
+template< typename T >
+T DebounceClass< T >::GetKeyLong( T key_mask )
 {
 	return( GetKeyPress( GetKeyRepeat( key_mask ) ) );
 }
+
+
+//==========================================================================
+//
+//		T E M P L A T E   I N S T A N C E S
+//
+//==========================================================================
+
+template class DebounceClass< uint8_t >;
+template class DebounceClass< uint16_t >;
+template class DebounceClass< uint32_t >;
@@ -7,6 +7,40 @@
 //#
 //#	This class provides functions that help debouncing digital inputs
 //#	connected to the ports of an Atmel.
+//#	The class is a template over the word type (uint8_t, uint16_t or
+//#	uint32_t), so one instance can debounce up to 32 inputs at once.
+//#
+//#	Each key has a vertical counter of three bits (one word per bit)
+//#	and its own number of samples (1 .. DEBOUNCE_MAX_SAMPLES) that
+//#	are needed for a press and for a release. The numbers are stored
+//#	as bit planes too, so all keys are still handled in parallel.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	4		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	three bit vertical counter with a number of samples for
+//#			press and release per key
+//#			new function
+//#				SetSamples()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	3		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	DebounceClass is a template over the word type
+//#			(instances for uint8_t, uint16_t and uint32_t
+//#			in debounce.cpp)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new function Confirm()
+//#			takes over a level that is known to be stable
 //#
 //#-------------------------------------------------------------------------
 //#
@@ -28,6 +62,19 @@
 #include <stdint.h>
 
 
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+//----------------------------------------------------------------------
+//	number of equal samples needed for a press or a release
+//
+#define DEBOUNCE_DEFAULT_SAMPLES	4
+#define DEBOUNCE_MAX_SAMPLES		7
+
+
 //==========================================================================
 //
 //		C L A S S   D E F I N I T I O N S
@@ -40,7 +87,9 @@
 //
 //	This class provides functions that help debouncing digital inputs
 //	connected to the ports of an Atmel.
+//	T is the word type, each bit of the word is one input.
 //
+template< typename T >
 class DebounceClass
 {
 	public:
@@ -51,7 +100,7 @@ class DebounceClass
 		//		repeatMask	Specifies in a bit mask for which keys the
 		//					repeat function will be switched on
 		//
-		DebounceClass( uint8_t repeatMask );
+		DebounceClass( T repeatMask );
 
 		//--------------------------------------------------------------
 		//	This is where the actual debouncing takes place.
@@ -59,9 +108,38 @@ class DebounceClass
 		//	and as often as possible.
 		//
 		//	Parameter:
-		//		keyIn	PIN value of the port that is to be debounced
+		//		keyIn	PIN value(s) of the input(s) to be debounced
 		//
-		void Work( uint8_t keyIn );
+		void Work( T keyIn );
+
+
+		//--------------------------------------------------------------
+		//	Takes over the level of the given keys as debounced state
+		//	without waiting for further calls of Work().
+		//	To be used if the level is known to be stable, e.g. no
+		//	edge was seen for some time.
+		//
+		//	Parameter:
+		//		key_mask	Specifies in a bit mask which keys should
+		//					be taken over
+		//		keyIn		PIN value(s) of the input(s)
+		//
+		void Confirm( T key_mask, T keyIn );
+
+
+		//--------------------------------------------------------------
+		//	Sets the number of equal samples that are needed before
+		//	a key is reported as pressed resp. as released.
+		//	Values out of the range 1 .. DEBOUNCE_MAX_SAMPLES will be
+		//	replaced by DEBOUNCE_DEFAULT_SAMPLES.
+		//
+		//	Parameter:
+		//		key_mask	Specifies in a bit mask for which keys the
+		//					numbers will be set
+		//		usPress		samples needed for a press
+		//		usRelease	samples needed for a release
+		//
+		void SetSamples( T key_mask, uint8_t usPress, uint8_t usRelease );
 
 
 		//--------------------------------------------------------------
@@ -73,7 +151,7 @@ class DebounceClass
 		//		key_mask	Specifies in a bit mask which keys should
 		//					be checked
 		//
-		uint8_t GetKeyPress( uint8_t key_mask );
+		T GetKeyPress( T key_mask );
 
 
 		//--------------------------------------------------------------
@@ -87,7 +165,7 @@ class DebounceClass
 		//		key_mask	Specifies in a bit mask which keys should
 		//					be checked
 		//
-		uint8_t GetKeyRepeat( uint8_t key_mask );
+		T GetKeyRepeat( T key_mask );
 
 
 		//--------------------------------------------------------------
@@ -98,7 +176,7 @@ class DebounceClass
 		//		key_mask	Specifies in a bit mask which keys should
 		//					be checked
 		//
-		uint8_t GetKeyState( uint8_t key_mask );
+		T GetKeyState( T key_mask );
 
 
 		//--------------------------------------------------------------
@@ -110,7 +188,7 @@ class DebounceClass
 		//		key_mask	Specifies in a bit mask which keys should
 		//					be checked
 		//
-		uint8_t GetKeyShort( uint8_t key_mask );
+		T GetKeyShort( T key_mask );
 
 
 		//--------------------------------------------------------------
@@ -122,7 +200,7 @@ class DebounceClass
 		//		key_mask	Specifies in a bit mask which keys should
 		//					be checked
 		//
-		uint8_t GetKeyLong( uint8_t key_mask );
+		T GetKeyLong( T key_mask );
 
 		//--------------------------------------------------------------
 		//	sets the repeat mask to enable the repeat function for
@@ -132,52 +210,65 @@ class DebounceClass
 		//		repeat_mask	Specifies in a bit mask for which keys the
 		//					repeat function will be switched on
 		//
-		inline void SetRepeatMask( uint8_t repeat_mask )
+		inline void SetRepeatMask( T repeat_mask )
 		{
-			m_usRepeatMask = repeat_mask;
+			m_tRepeatMask = repeat_mask;
 		};
 
 	private:
 		//--------------------------------------------------------------
-		//		m_usRepeatMask
+		//	the prefix 't' marks the word type T of the template
+		//
+		//--------------------------------------------------------------
+		//		m_tRepeatMask
 		//
 		//	contains the mask for which keys the repeat function
 		//	is activated.
 		//
-		uint8_t	m_usRepeatMask;
+		T		m_tRepeatMask;
 
 		//--------------------------------------------------------------
-		//		m_usKeyState
+		//		m_tKeyState
 		//
 		//	bit field containing the debounced current key state
 		//	(bit set = key pressed)
 		//
-		uint8_t m_usKeyState;
+		T		m_tKeyState;
 
 		//--------------------------------------------------------------
-		//		m_usKeyPress
+		//		m_tKeyPress
 		//
 		//	bit field containing all newly pressed keys since the last
 		//	call of function GetKeyPress, GetKeyShort or GetKeyLong.
 		//	(bit set = key pressed)
 		//
-		uint8_t m_usKeyPress;
+		T		m_tKeyPress;
 
 		//--------------------------------------------------------------
-		//		m_usKeyRepeat
+		//		m_tKeyRepeat
 		//	bit field containing all pressed keys that have reached
 		//	the repeat state
 		//	(bit set = key in repeat state)
 		//
-		uint8_t m_usKeyRepeat;
+		T		m_tKeyRepeat;
 
 		//--------------------------------------------------------------
-		//		m_usDebounce1
-		//		m_usDebounce2
+		//		m_artCounter
 		//		m_usRepeatCounter
 		//	help variables to carry out the key debouncing
+		//	m_artCounter holds the three bits of the vertical counter
+		//	of each key: the number of samples that differ from the
+		//	debounced state
+		//
+		T		m_artCounter[ 3 ];
+		uint8_t	m_usRepeatCounter;
+
+		//--------------------------------------------------------------
+		//		m_artPress
+		//		m_artRelease
+		//	number of samples needed for a press resp. a release,
+		//	three bit planes like the counter
 		//
-		uint8_t m_usDebounce1;
-		uint8_t m_usDebounce2;
-		uint8_t m_usRepeatCounter;
+		T		m_artPress[ 3 ];
+		T		m_artRelease[ 3 ];
 };
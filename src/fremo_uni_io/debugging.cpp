@@ -7,6 +7,98 @@
 //#
 //#-------------------------------------------------------------------------
 //#
+//#	File version:	11		vom: 17.10.2026
+//#
+//#	Bugfix:
+//#		-	the max fill of the send queue and the dropped events
+//#			are shown behind the headings of the status lines
+//#			instead of on the message line. They overwrote the
+//#			texts of 'PrintText()', 'PrintCounter()' and
+//#			'PrintMsgCount()' at the next refresh of the status.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	10		vom: 17.10.2026
+//#
+//#	Bugfix:
+//#		-	the message counter is incremented by the callback
+//#			again, the event only shows it. Messages whose event
+//#			was dropped were not counted.
+//#		-	the counter is 'g_ulSwitchMsgCounter' as used by
+//#			'PrintMsgCount()' (was declared as
+//#			'g_ulSensorMsgCounter')
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	9		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the Loconet callbacks only record events, they are
+//#			formatted and shown by 'ShowNextEvent()'
+//#			new functions
+//#				AddEvent()
+//#				ShowNextEvent()
+//#		-	the status line shows the number of dropped events,
+//#			if there are any
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	8		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	all texts are written into the display buffer, the
+//#			display follows in the background
+//#			(see display_buffer.h)
+//#			new functions
+//#				RefreshDisplay()
+//#				DisplayInBackground()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	7		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	'PrintStatus()' does nothing as long as the status is
+//#			unchanged. Otherwise only the characters that have
+//#			changed are sent to the display.
+//#			Functions that overwrite the lines of the status make
+//#			the next 'PrintStatus()' draw them completely.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	6		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new function PrintBootTimes()
+//#			shows the times of the start up phases in the lines of
+//#			the Loconet message until the first message arrives
+//#			 S                     1 1 1 1 1 1
+//#			Z  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5
+//#			5  E : e e e e e   C : c c c c c
+//#			6  I : i i i i i   R : r r r r r
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	5		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new function PrintStorageCorrupt()
+//#			shows the stored and the calculated CRC of the LNCVs
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	4		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	show the maximum fill level of the send queue in line 7
+//#			change in function
+//#				PrintStatus()
+//#			 S                     1 1 1 1 1 1
+//#			Z  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5
+//#			7  S e n d Q   m a x :   x x
+//#
+//#-------------------------------------------------------------------------
+//#
 //#	File version:	3		vom: 29.01.2023
 //#
 //#	Implementation:
@@ -78,9 +170,9 @@
 
 
 #include <avr/pgmspace.h>
-#include <Wire.h>
-#include <simple_oled_sh1106.h>
 
+#include "boot_phases.h"
+#include "display_buffer.h"
 #include "debugging.h"
 
 
@@ -101,6 +193,16 @@
 #define	LOCONET_MSG_LINE		5
 #define LOCONET_MSG_COLUMN		0
 #define MESSAGE_LINE			7
+#define SEND_QUEUE_LINE			1		//	behind "Input State:"
+#define SEND_QUEUE_COLUMN		12
+#define DROPPED_LINE			3		//	behind "Output State:"
+#define DROPPED_COLUMN			13
+
+//----------------------------------------------------------------------
+//	parts of the status that are shown on the display
+//
+#define STATUS_VALID_STATE		0x01
+#define STATUS_VALID_QUEUE		0x02
 
 
 //------------------------------------------------------------------
@@ -126,7 +228,7 @@ char		g_chDebugString[ 18 ];
 
 #if defined( COUNT_ALL_MESSAGES ) || defined( COUNT_MY_MESSAGES )
 
-uint32_t	g_ulSensorMsgCounter	= 0L;
+uint32_t	g_ulSwitchMsgCounter	= 0L;
 
 
 //==========================================================================
@@ -141,9 +243,9 @@ uint32_t	g_ulSensorMsgCounter	= 0L;
 //
 void PrintMsgCount( void )
 {
-	g_clDisplay.ClearLine( MESSAGE_LINE );
+	g_clDisplayBuffer.ClearLine( MESSAGE_LINE );
 	sprintf( g_chDebugString, "Switch: %8lu", g_ulSwitchMsgCounter );
-	g_clDisplay.Print( g_chDebugString );
+	g_clDisplayBuffer.Print( g_chDebugString );
 }
 
 #endif	//	defined( COUNT_ALL_MESSAGES ) || defined( COUNT_MY_MESSAGES )
@@ -166,7 +268,16 @@ void PrintMsgCount( void )
 //
 DebuggingClass::DebuggingClass()
 {
-	m_counter = 0;
+	m_counter			= 0;
+	m_uiShownAsOutputs	= 0x0000;
+	m_uiShownOutState	= 0x0000;
+	m_uiShownInState	= 0x0000;
+	m_usShownQueueMax	= 0;
+	m_usStatusValid		= 0;
+	m_uiShownDropped	= 0;
+	m_usEventRead		= 0;
+	m_usEventCount		= 0;
+	m_uiEventsDropped	= 0;
 }
 
 
@@ -176,8 +287,31 @@ DebuggingClass::DebuggingClass()
 //
 void DebuggingClass::Init( void )
 {
-	g_clDisplay.Init();
-	g_clDisplay.Flip( true );
+	g_clDisplayBuffer.Init();
+}
+
+
+//******************************************************************
+//	DisplayInBackground
+//------------------------------------------------------------------
+//	from now on the texts are sent to the display by
+//	'RefreshDisplay()' (end of 'setup()')
+//
+void DebuggingClass::DisplayInBackground( void )
+{
+	g_clDisplayBuffer.SetBackground( true );
+}
+
+
+//******************************************************************
+//	RefreshDisplay
+//------------------------------------------------------------------
+//	sends the next changed characters to the display
+//	(called in each pass of 'loop()')
+//
+void DebuggingClass::RefreshDisplay( void )
+{
+	g_clDisplayBuffer.Refresh();
 }
 
 
@@ -189,12 +323,14 @@ void DebuggingClass::PrintTitle(	uint8_t versionMain,
 									uint8_t versionMinor,
 									uint8_t versionHotFix )
 {
-	g_clDisplay.Clear();
-	g_clDisplay.SetInverseFont( true );
+	m_usStatusValid = 0;
+
+	g_clDisplayBuffer.Clear();
+	g_clDisplayBuffer.SetInverseFont( true );
 	sprintf(	g_chDebugString, "  Uni V%u.%02u.%02u  ",
 				versionMain, versionMinor, versionHotFix );
-	g_clDisplay.Print( g_chDebugString );
-	g_clDisplay.SetInverseFont( false );
+	g_clDisplayBuffer.Print( g_chDebugString );
+	g_clDisplayBuffer.SetInverseFont( false );
 }
 
 
@@ -204,19 +340,21 @@ void DebuggingClass::PrintTitle(	uint8_t versionMain,
 //
 void DebuggingClass::PrintInfoLine( info_lines_t number )
 {
+	m_usStatusValid = 0;
+
 	switch( number )
 	{
 		case infoLineFields:
-			g_clDisplay.Print( F( "\nInput State:\n" ) );
-			g_clDisplay.Print( F( "\nOutput State:"  ) );
+			g_clDisplayBuffer.Print( F( "\nInput State:\n" ) );
+			g_clDisplayBuffer.Print( F( "\nOutput State:"  ) );
 			break;
 
 		case infoLineInit:
-			g_clDisplay.Print( F( "\n  Init:\n" ) );
+			g_clDisplayBuffer.Print( F( "\n  Init:\n" ) );
 			break;
 
 		case infoLineLedTest:
-			g_clDisplay.Print( F( "  LED Test\n" ) );
+			g_clDisplayBuffer.Print( F( "  LED Test\n" ) );
 			break;
 
 		default:
@@ -231,8 +369,8 @@ void DebuggingClass::PrintInfoLine( info_lines_t number )
 //
 void DebuggingClass::PrintText( char *text )
 {
-	g_clDisplay.ClearLine( MESSAGE_LINE );
-	g_clDisplay.Print( text );
+	g_clDisplayBuffer.ClearLine( MESSAGE_LINE );
+	g_clDisplayBuffer.Print( text );
 }
 
 
@@ -243,27 +381,25 @@ void DebuggingClass::PrintText( char *text )
 void DebuggingClass::PrintCounter( void )
 {
 	m_counter++;
-	
-	g_clDisplay.ClearLine( MESSAGE_LINE );
+	g_clDisplayBuffer.ClearLine( MESSAGE_LINE );
 	sprintf( g_chDebugString, "Counter: %lu", m_counter );
-	g_clDisplay.Print( g_chDebugString );
+	g_clDisplayBuffer.Print( g_chDebugString );
 }
 
 
 //******************************************************************
 //	PrintNotifyType
 //------------------------------------------------------------------
+//	the type is used by the next 'PrintNotifyMsg()'
 //
 void DebuggingClass::PrintNotifyType( notify_type_t type )
 {
 	m_NotifyType = type;
 
 #ifdef COUNT_ALL_MESSAGES
-
 	g_ulSwitchMsgCounter++;
 
-	PrintMsgCount();
-
+	AddEvent( DE_MsgCount, 0, 0, 0 );
 #endif
 }
 
@@ -274,37 +410,12 @@ void DebuggingClass::PrintNotifyType( notify_type_t type )
 //
 void DebuggingClass::PrintNotifyMsg( uint16_t address, uint8_t dir )
 {
-	SetLncvMsgPos();
-
-	switch( m_NotifyType )
-	{
-		case NT_Sensor:
-			g_clDisplay.Print( F( "E:Sensor\n" ) );
-			break;
-
-		case NT_Request:
-			g_clDisplay.Print( F( "E:Switch Reqst\n" ) );
-			break;
-
-		case NT_Report:
-			g_clDisplay.Print( F( "E:Switch Report\n" ) );
-			break;
-
-		case NT_State:
-			g_clDisplay.Print( F( "E:Switch State\n" ) );
-			break;
-	}
-
-	sprintf( g_chDebugString, "Idx:%3u - ", address );
-	g_clDisplay.Print( g_chDebugString );
-	g_clDisplay.Print( (dir ? "green" : "red  ") );
+	AddEvent( DE_NotifyMsg, address, 0, m_NotifyType | (dir ? 0x80 : 0x00) );
 
 #ifdef COUNT_MY_MESSAGES
-
 	g_ulSwitchMsgCounter++;
 
-	PrintMsgCount();
-
+	AddEvent( DE_MsgCount, 0, 0, 0 );
 #endif
 }
 
@@ -314,19 +425,7 @@ void DebuggingClass::PrintNotifyMsg( uint16_t address, uint8_t dir )
 //
 void DebuggingClass::PrintLncvDiscoverStart( bool start, uint16_t artikel, uint16_t address )
 {
-	SetLncvMsgPos();
-
-	if( start )
-	{
-		g_clDisplay.Print( F( "LNCV Prog Start\n" ) );
-	}
-	else
-	{
-		g_clDisplay.Print( F( "LNCV Discover\n" ) );
-	}
-	
-	sprintf( g_chDebugString, "AR%5u AD%5u", artikel, address );
-	g_clDisplay.Print( g_chDebugString );
+	AddEvent( (start ? DE_LncvStart : DE_LncvDiscover), artikel, address, 0 );
 }
 
 
@@ -335,10 +434,7 @@ void DebuggingClass::PrintLncvDiscoverStart( bool start, uint16_t artikel, uint1
 //
 void DebuggingClass::PrintLncvStop()
 {
-	SetLncvMsgPos();
-	g_clDisplay.Print( F( "LNCV Prog Stop" ) );
-//	sprintf( g_chDebugString, "AR%5u AD%5u", ArtNr, ModuleAddress );
-//	g_clDisplay.Print( g_chDebugString );
+	AddEvent( DE_LncvStop, 0, 0, 0 );
 }
 
 
@@ -347,19 +443,136 @@ void DebuggingClass::PrintLncvStop()
 //
 void DebuggingClass::PrintLncvReadWrite( bool doRead, uint16_t address, uint16_t value )
 {
-	SetLncvMsgPos();
+	AddEvent( (doRead ? DE_LncvRead : DE_LncvWrite), address, value, 0 );
+}
+
+
+//******************************************************************
+//	AddEvent
+//------------------------------------------------------------------
+//	records the event in the ring, if the ring is full the event
+//	is dropped
+//
+void DebuggingClass::AddEvent(	debug_event_type_t type, uint16_t uiAddress,
+								uint16_t uiValue, uint8_t usInfo				)
+{
+	debug_event_t *	pEvent;
+
+	if( DEBUG_EVENT_RING_SIZE <= m_usEventCount )
+	{
+		m_uiEventsDropped++;
+
+		return;
+	}
+
+	pEvent = &m_arEvent[ (m_usEventRead + m_usEventCount) & (DEBUG_EVENT_RING_SIZE - 1) ];
+
+	pEvent->uiAddress	= uiAddress;
+	pEvent->uiValue		= uiValue;
+	pEvent->usType		= type;
+	pEvent->usInfo		= usInfo;
+
+	m_usEventCount++;
+}
+
+
+//******************************************************************
+//	ShowNextEvent
+//------------------------------------------------------------------
+//	shows the oldest event of the ring on the display
+//	returns false if there was no event
+//
+bool DebuggingClass::ShowNextEvent( void )
+{
+	debug_event_t *	pEvent;
 
-	if( doRead )
+	if( 0 == m_usEventCount )
 	{
-		g_clDisplay.Print( F( "LNCV Read\n" ) );
+		return( false );
 	}
-	else
+
+	pEvent = &m_arEvent[ m_usEventRead ];
+
+	m_usEventRead = (m_usEventRead + 1) & (DEBUG_EVENT_RING_SIZE - 1);
+	m_usEventCount--;
+
+	if( DE_MsgCount == pEvent->usType )
 	{
-		g_clDisplay.Print( F( "LNCV Write\n" ) );
+#if defined( COUNT_ALL_MESSAGES ) || defined( COUNT_MY_MESSAGES )
+		PrintMsgCount();
+#endif
+
+		return( true );
 	}
 
-	sprintf( g_chDebugString, "AD%5u VA%5u", address, value );
-	g_clDisplay.Print( g_chDebugString );
+	SetLncvMsgPos();
+
+	switch( pEvent->usType )
+	{
+		case DE_NotifyMsg:
+			switch( pEvent->usInfo & 0x7F )
+			{
+				case NT_Sensor:
+					g_clDisplayBuffer.Print( F( "E:Sensor\n" ) );
+					break;
+
+				case NT_Request:
+					g_clDisplayBuffer.Print( F( "E:Switch Reqst\n" ) );
+					break;
+
+				case NT_Report:
+					g_clDisplayBuffer.Print( F( "E:Switch Report\n" ) );
+					break;
+
+				case NT_State:
+					g_clDisplayBuffer.Print( F( "E:Switch State\n" ) );
+					break;
+			}
+
+			sprintf( g_chDebugString, "Idx:%3u - ", pEvent->uiAddress );
+			g_clDisplayBuffer.Print( g_chDebugString );
+			g_clDisplayBuffer.Print( ((pEvent->usInfo & 0x80) ? "green" : "red  ") );
+			break;
+
+		case DE_LncvDiscover:
+		case DE_LncvStart:
+			if( DE_LncvStart == pEvent->usType )
+			{
+				g_clDisplayBuffer.Print( F( "LNCV Prog Start\n" ) );
+			}
+			else
+			{
+				g_clDisplayBuffer.Print( F( "LNCV Discover\n" ) );
+			}
+
+			sprintf( g_chDebugString, "AR%5u AD%5u", pEvent->uiAddress, pEvent->uiValue );
+			g_clDisplayBuffer.Print( g_chDebugString );
+			break;
+
+		case DE_LncvStop:
+			g_clDisplayBuffer.Print( F( "LNCV Prog Stop" ) );
+			break;
+
+		case DE_LncvRead:
+		case DE_LncvWrite:
+			if( DE_LncvRead == pEvent->usType )
+			{
+				g_clDisplayBuffer.Print( F( "LNCV Read\n" ) );
+			}
+			else
+			{
+				g_clDisplayBuffer.Print( F( "LNCV Write\n" ) );
+			}
+
+			sprintf( g_chDebugString, "AD%5u VA%5u", pEvent->uiAddress, pEvent->uiValue );
+			g_clDisplayBuffer.Print( g_chDebugString );
+			break;
+
+		default:
+			break;
+	}
+
+	return( true );
 }
 
 
@@ -368,8 +581,8 @@ void DebuggingClass::PrintLncvReadWrite( bool doRead, uint16_t address, uint16_t
 //
 void DebuggingClass::SetLncvMsgPos( void )
 {
-	g_clDisplay.ClearLine( LOCONET_MSG_LINE + 1 );
-	g_clDisplay.ClearLine( LOCONET_MSG_LINE );
+	g_clDisplayBuffer.ClearLine( LOCONET_MSG_LINE + 1 );
+	g_clDisplayBuffer.ClearLine( LOCONET_MSG_LINE );
 }
 
 
@@ -378,9 +591,9 @@ void DebuggingClass::SetLncvMsgPos( void )
 //
 void DebuggingClass::PrintStorageCheck( uint16_t uiAddress, uint16_t uiArticle )
 {
-	g_clDisplay.Print( F( "Check EEPROM:\n" ) );
+	g_clDisplayBuffer.Print( F( "Check EEPROM:\n" ) );
 	sprintf( g_chDebugString, " 0:%05d 1:%05d", uiAddress, uiArticle );
-	g_clDisplay.Print( g_chDebugString );
+	g_clDisplayBuffer.Print( g_chDebugString );
 }
 
 
@@ -389,7 +602,18 @@ void DebuggingClass::PrintStorageCheck( uint16_t uiAddress, uint16_t uiArticle )
 //
 void DebuggingClass::PrintStorageDefault( void )
 {
-	g_clDisplay.Print( F( "\nSet default Adr" ) );
+	g_clDisplayBuffer.Print( F( "\nSet default Adr" ) );
+}
+
+
+//******************************************************************
+//	PrintStorageCorrupt
+//
+void DebuggingClass::PrintStorageCorrupt( uint16_t uiStoredCrc, uint16_t uiCrc )
+{
+	g_clDisplayBuffer.Print( F( "\nCRC error:\n" ) );
+	sprintf( g_chDebugString, " %04X <> %04X", uiStoredCrc, uiCrc );
+	g_clDisplayBuffer.Print( g_chDebugString );
 }
 
 
@@ -398,7 +622,7 @@ void DebuggingClass::PrintStorageDefault( void )
 //
 void DebuggingClass::PrintStorageRead( void )
 {
-	g_clDisplay.Print( F( "\n  Lese LNCVs\n" ) );
+	g_clDisplayBuffer.Print( F( "\n  Lese LNCVs\n" ) );
 }
 
 
@@ -412,51 +636,53 @@ void DebuggingClass::PrintStorageConfig(	uint16_t uiAsOutputs,
 	uint16_t	uiMask = 0x8000;
 	uint8_t		idx;
 
-	g_clDisplay.Print( F( "\nOutput:\n" ) );
+	m_usStatusValid = 0;
+
+	g_clDisplayBuffer.Print( F( "\nOutput:\n" ) );
 
 	for( idx = 0 ; IO_NUMBERS > idx ; idx++ )
 	{
 		if( uiAsOutputs & uiMask )
 		{
-			g_clDisplay.Print( "O" );
+			g_clDisplayBuffer.Print( "O" );
 		}
 		else
 		{
-			g_clDisplay.Print( "." );
+			g_clDisplayBuffer.Print( "." );
 		}
 
 		uiMask >>= 1;
 	}
 
-	g_clDisplay.Print( F( "\nSensor:\n" ) );
+	g_clDisplayBuffer.Print( F( "\nSensor:\n" ) );
 	uiMask = 0x8000;
 
 	for( idx = 0 ; IO_NUMBERS > idx ; idx++ )
 	{
 		if( uiAsSensors & uiMask )
 		{
-			g_clDisplay.Print( "S" );
+			g_clDisplayBuffer.Print( "S" );
 		}
 		else
 		{
-			g_clDisplay.Print( "." );
+			g_clDisplayBuffer.Print( "." );
 		}
 
 		uiMask >>= 1;
 	}
 
-	g_clDisplay.Print( F( "\nInvert:\n" ) );
+	g_clDisplayBuffer.Print( F( "\nInvert:\n" ) );
 	uiMask = 0x8000;
 
 	for( idx = 0 ; IO_NUMBERS > idx ; idx++ )
 	{
 		if( uiIsInverse & uiMask )
 		{
-			g_clDisplay.Print( "I" );
+			g_clDisplayBuffer.Print( "I" );
 		}
 		else
 		{
-			g_clDisplay.Print( "." );
+			g_clDisplayBuffer.Print( "." );
 		}
 
 		uiMask >>= 1;
@@ -464,41 +690,134 @@ void DebuggingClass::PrintStorageConfig(	uint16_t uiAsOutputs,
 }
 
 
+//******************************************************************
+//	PrintBootTimes
+//------------------------------------------------------------------
+//	'puiBootTime' points to BOOT_PHASE_COUNT times (see boot_phases.h)
+//
+void DebuggingClass::PrintBootTimes( const uint16_t *puiBootTime )
+{
+	g_clDisplayBuffer.ClearLine( LOCONET_MSG_LINE );
+	g_clDisplayBuffer.ClearLine( LOCONET_MSG_LINE + 1 );
+
+	g_clDisplayBuffer.SetCursor( LOCONET_MSG_LINE, LOCONET_MSG_COLUMN );
+	sprintf(	g_chDebugString, "E:%5u C:%5u",
+				puiBootTime[ BOOT_PHASE_EEPROM ], puiBootTime[ BOOT_PHASE_CONFIG ]	);
+	g_clDisplayBuffer.Print( g_chDebugString );
+
+	g_clDisplayBuffer.SetCursor( LOCONET_MSG_LINE + 1, LOCONET_MSG_COLUMN );
+	sprintf(	g_chDebugString, "I:%5u R:%5u",
+				puiBootTime[ BOOT_PHASE_INPUTS ], puiBootTime[ BOOT_PHASE_READY ]	);
+	g_clDisplayBuffer.Print( g_chDebugString );
+}
+
+
 //******************************************************************
 //	PrintStatus
+//------------------------------------------------------------------
+//	Only the characters that differ from the status shown on the
+//	display are sent. A character changes if the pin changes its
+//	direction or if the state of a pin, that is shown, changes.
 //
 void DebuggingClass::PrintStatus(	uint16_t uiAsOutputs,
 									uint16_t uiOutState,
-									uint16_t uiInState )
+									uint16_t uiInState,
+									uint8_t  usSendQueueMax )
 {
-	g_clDisplay.SetCursor( INPUT_STATE_LINE, STATE_COLUMN );
-	PrintStatusBits( uiAsOutputs, uiInState );
+	uint16_t	uiChangedIn		= 0xFFFF;
+	uint16_t	uiChangedOut	= 0xFFFF;
+	uint16_t	uiChangedDir;
 
-	g_clDisplay.SetCursor( OUTPUT_STATE_LINE, STATE_COLUMN );
-	PrintStatusBits( ~uiAsOutputs, uiOutState );
+	if( m_usStatusValid & STATUS_VALID_STATE )
+	{
+		uiChangedDir	= uiAsOutputs ^ m_uiShownAsOutputs;
+		uiChangedIn		= uiChangedDir | (~uiAsOutputs & (uiInState  ^ m_uiShownInState ));
+		uiChangedOut	= uiChangedDir | ( uiAsOutputs & (uiOutState ^ m_uiShownOutState));
+	}
+
+	if( 0x0000 != uiChangedIn )
+	{
+		PrintStatusBits( INPUT_STATE_LINE, uiAsOutputs, uiInState, uiChangedIn );
+	}
+
+	if( 0x0000 != uiChangedOut )
+	{
+		PrintStatusBits( OUTPUT_STATE_LINE, ~uiAsOutputs, uiOutState, uiChangedOut );
+	}
+
+	if(		!(m_usStatusValid & STATUS_VALID_QUEUE)
+		||	(usSendQueueMax != m_usShownQueueMax)		)
+	{
+		g_clDisplayBuffer.SetCursor( SEND_QUEUE_LINE, SEND_QUEUE_COLUMN );
+		sprintf( g_chDebugString, " Q%2u", usSendQueueMax );
+		g_clDisplayBuffer.Print( g_chDebugString );
+	}
+
+	if(		!(m_usStatusValid & STATUS_VALID_QUEUE)
+		||	(m_uiEventsDropped != m_uiShownDropped)		)
+	{
+		g_clDisplayBuffer.SetCursor( DROPPED_LINE, DROPPED_COLUMN );
+
+		if( 0 == m_uiEventsDropped )
+		{
+			g_clDisplayBuffer.Print( F( "   " ) );
+		}
+		else
+		{
+			sprintf(	g_chDebugString, "D%2u",
+						(99 < m_uiEventsDropped) ? 99 : m_uiEventsDropped	);
+			g_clDisplayBuffer.Print( g_chDebugString );
+		}
+	}
+
+	m_uiShownAsOutputs	= uiAsOutputs;
+	m_uiShownOutState	= uiOutState;
+	m_uiShownInState	= uiInState;
+	m_usShownQueueMax	= usSendQueueMax;
+	m_uiShownDropped	= m_uiEventsDropped;
+	m_usStatusValid		= STATUS_VALID_STATE | STATUS_VALID_QUEUE;
 }
 
 
 //******************************************************************
 //	PrintStatusBits
+//------------------------------------------------------------------
+//	prints the characters of 'usLine' whose bit is set in
+//	'uiChanged'. The cursor is only set at the start of each
+//	group of changed characters.
 //
-void DebuggingClass::PrintStatusBits( uint16_t uiIOMask, uint16_t uiState )
+void DebuggingClass::PrintStatusBits(	uint8_t usLine, uint16_t uiIOMask,
+										uint16_t uiState, uint16_t uiChanged	)
 {
-	uint16_t	uiMask	= 0x8000;
+	uint16_t	uiMask		= 0x8000;
+	bool		bAtCursor	= false;
 
 	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
 	{
-		if( uiIOMask & uiMask )
-		{
-			g_clDisplay.Print( "." );
-		}
-		else if( uiState & uiMask )
+		if( !(uiChanged & uiMask) )
 		{
-			g_clDisplay.Print( "1" );
+			bAtCursor = false;
 		}
 		else
 		{
-			g_clDisplay.Print( "0" );
+			if( !bAtCursor )
+			{
+				g_clDisplayBuffer.SetCursor( usLine, STATE_COLUMN + idx );
+				bAtCursor = true;
+			}
+
+			if( uiIOMask & uiMask )
+			{
+				g_clDisplayBuffer.Print( "." );
+			}
+			else if( uiState & uiMask )
+			{
+				g_clDisplayBuffer.Print( "1" );
+			}
+			else
+			{
+				g_clDisplayBuffer.Print( "0" );
+			}
 		}
 
 		uiMask >>= 1;
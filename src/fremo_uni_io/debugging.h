@@ -10,6 +10,65 @@
 //#
 //#-------------------------------------------------------------------------
 //#
+//#	File version:	9		vom: 17.10.2026
+//#
+//#	Bugfix:
+//#		-	debug_event_t without the unused time of the event
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	8		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the functions called by the Loconet callbacks
+//#			(PrintNotifyType(), PrintNotifyMsg(), PrintLncvxxx())
+//#			only record an event in a ring. The events are shown by
+//#			'ShowNextEvent()' when 'loop()' has nothing to send.
+//#			If the ring is full, the event is dropped and counted.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	7		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the texts are written into a display buffer
+//#			new functions
+//#				DisplayInBackground()
+//#				RefreshDisplay()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	6		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	'PrintStatus()' keeps the state shown on the display and
+//#			sends only the characters that have changed
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	5		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new function PrintBootTimes()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	4		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new function PrintStorageCorrupt()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	3		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	show the maximum fill level of the send queue
+//#			change in function
+//#				PrintStatus()
+//#
+//#-------------------------------------------------------------------------
+//#
 //#	File version:	2		vom: 29.01.2023
 //#
 //#	Implementation:
@@ -59,6 +118,35 @@ typedef enum notify_type
 }	notify_type_t;
 
 
+//----------------------------------------------------------------------
+//	debug events, recorded by the Loconet callbacks
+//	(DEBUG_EVENT_RING_SIZE is a power of 2)
+//
+#define DEBUG_EVENT_RING_SIZE		8
+
+typedef enum debug_event_type
+{
+	DE_NotifyMsg = 0,		//	uiAddress: pin, usInfo: notify type | 0x80 (green)
+	DE_MsgCount,			//	COUNT_ALL_MESSAGES, COUNT_MY_MESSAGES: show counter
+	DE_LncvDiscover,		//	uiAddress: article, uiValue: module address
+	DE_LncvStart,			//	uiAddress: article, uiValue: module address
+	DE_LncvStop,
+	DE_LncvRead,			//	uiAddress: LNCV, uiValue: value
+	DE_LncvWrite			//	uiAddress: LNCV, uiValue: value
+
+}	debug_event_type_t;
+
+
+typedef struct debug_event
+{
+	uint16_t	uiAddress;
+	uint16_t	uiValue;
+	uint8_t		usType;			//	debug_event_type_t
+	uint8_t		usInfo;
+
+}	debug_event_t;
+
+
 //==========================================================================
 //
 //		C L A S S   D E F I N I T I O N S
@@ -75,6 +163,8 @@ class DebuggingClass
 		DebuggingClass();
 
 		void Init( void );
+		void DisplayInBackground( void );
+		void RefreshDisplay( void );
 
 		void PrintTitle(	uint8_t versionMain,
 							uint8_t versionMinor,
@@ -94,12 +184,17 @@ class DebuggingClass
 
 		void PrintStorageCheck( uint16_t uiAddress, uint16_t uiArticle );
 		void PrintStorageDefault( void );
+		void PrintStorageCorrupt( uint16_t uiStoredCrc, uint16_t uiCrc );
 		void PrintStorageRead( void );
 		void PrintStorageConfig( uint16_t uiAsOutputs, uint16_t uiAsSensors, uint16_t uiIsInverse );
+		void PrintBootTimes( const uint16_t *puiBootTime );
+
+		bool ShowNextEvent( void );
 
 		void PrintStatus(	uint16_t uiAsOutputs,
 							uint16_t uiOutState,
-							uint16_t uiInState		);
+							uint16_t uiInState,
+							uint8_t  usSendQueueMax	);
 
 		void PrintText( char *text );
 		void PrintCounter( void );
@@ -108,8 +203,31 @@ class DebuggingClass
 		notify_type_t	m_NotifyType;
 		uint32_t		m_counter;
 
+		//----------------------------------------------------------
+		//	status shown on the display
+		//	m_usStatusValid		which parts of the status are shown
+		//						(STATUS_VALID_xxx, see debugging.cpp)
+		//
+		uint16_t		m_uiShownAsOutputs;
+		uint16_t		m_uiShownOutState;
+		uint16_t		m_uiShownInState;
+		uint8_t			m_usShownQueueMax;
+		uint8_t			m_usStatusValid;
+		uint16_t		m_uiShownDropped;
+
+		//----------------------------------------------------------
+		//	ring of the debug events
+		//
+		debug_event_t	m_arEvent[ DEBUG_EVENT_RING_SIZE ];
+		uint8_t			m_usEventRead;
+		uint8_t			m_usEventCount;
+		uint16_t		m_uiEventsDropped;
+
+		void AddEvent(	debug_event_type_t type, uint16_t uiAddress,
+						uint16_t uiValue, uint8_t usInfo				);
 		void SetLncvMsgPos( void );
-		void PrintStatusBits( uint16_t uiIOMask, uint16_t uiState );
+		void PrintStatusBits(	uint8_t usLine, uint16_t uiIOMask,
+								uint16_t uiState, uint16_t uiChanged	);
 };
 
 
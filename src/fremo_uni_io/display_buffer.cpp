@@ -0,0 +1,335 @@
+//##########################################################################
+//#
+//#		DisplayBufferClass
+//#
+//#	This class keeps the content of the OLED display in RAM and
+//#	sends the changes in the background (see display_buffer.h).
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include "compile_options.h"
+
+
+#ifdef DEBUGGING_PRINTOUT
+//**************************************************************************
+//**************************************************************************
+
+
+#include <string.h>
+#include <avr/pgmspace.h>
+#include <Wire.h>
+#include <simple_oled_sh1106.h>
+
+#include "display_buffer.h"
+
+
+//==========================================================================
+//
+//		G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+DisplayBufferClass	g_clDisplayBuffer	= DisplayBufferClass();
+
+
+//==========================================================================
+//
+//		C L A S S   F U N C T I O N S
+//
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////
+//	CLASS: DisplayBufferClass
+//
+
+//**********************************************************************
+//	Constructor
+//----------------------------------------------------------------------
+//	the buffer starts with a cleared display
+//
+DisplayBufferClass::DisplayBufferClass()
+{
+	for( uint8_t usLine = 0 ; usLine < DISPLAY_LINES ; usLine++ )
+	{
+		memset( m_archCell[ usLine ], ' ', DISPLAY_COLUMNS );
+
+		m_aruiDirty[ usLine ]	= 0x0000;
+		m_aruiInverse[ usLine ]	= 0x0000;
+	}
+
+	m_usLine		= 0;
+	m_usColumn		= 0;
+	m_usRefresh		= 0;
+	m_bInverse		= false;
+	m_bBackground	= false;
+}
+
+
+//**********************************************************************
+//	Init
+//----------------------------------------------------------------------
+//
+void DisplayBufferClass::Init( void )
+{
+	g_clDisplay.Init();
+	g_clDisplay.Flip( true );
+	g_clDisplay.Clear();
+}
+
+
+//**********************************************************************
+//	Clear
+//----------------------------------------------------------------------
+//
+void DisplayBufferClass::Clear( void )
+{
+	bool	bBackground	= m_bBackground;
+
+	m_bBackground = true;
+
+	for( uint8_t usLine = 0 ; usLine < DISPLAY_LINES ; usLine++ )
+	{
+		ClearLine( usLine );
+	}
+
+	m_bBackground	= bBackground;
+	m_usLine		= 0;
+	m_usColumn		= 0;
+
+	if( !m_bBackground )
+	{
+		Flush();
+	}
+}
+
+
+//**********************************************************************
+//	ClearLine
+//----------------------------------------------------------------------
+//	the cursor is set to the start of the line
+//
+void DisplayBufferClass::ClearLine( uint8_t usLine )
+{
+	bool	bInverse	= m_bInverse;
+
+	m_usLine	= usLine;
+	m_usColumn	= 0;
+	m_bInverse	= false;
+
+	while( DISPLAY_COLUMNS > m_usColumn )
+	{
+		PutChar( ' ' );
+	}
+
+	m_bInverse	= bInverse;
+	m_usColumn	= 0;
+
+	if( !m_bBackground )
+	{
+		Flush();
+	}
+}
+
+
+//**********************************************************************
+//	SetCursor
+//----------------------------------------------------------------------
+//
+void DisplayBufferClass::SetCursor( uint8_t usLine, uint8_t usColumn )
+{
+	m_usLine	= usLine;
+	m_usColumn	= usColumn;
+}
+
+
+//**********************************************************************
+//	SetInverseFont
+//----------------------------------------------------------------------
+//
+void DisplayBufferClass::SetInverseFont( bool bInverse )
+{
+	m_bInverse = bInverse;
+}
+
+
+//**********************************************************************
+//	Print
+//----------------------------------------------------------------------
+//	'\n' sets the cursor to the start of the next line,
+//	characters beyond the end of the line are lost
+//
+void DisplayBufferClass::Print( const char *pchText )
+{
+	while( *pchText )
+	{
+		PutChar( *pchText++ );
+	}
+
+	if( !m_bBackground )
+	{
+		Flush();
+	}
+}
+
+
+void DisplayBufferClass::Print( const __FlashStringHelper *pText )
+{
+	const char *	pchText	= reinterpret_cast< const char * >( pText );
+	char			chChar	= pgm_read_byte( pchText++ );
+
+	while( chChar )
+	{
+		PutChar( chChar );
+
+		chChar = pgm_read_byte( pchText++ );
+	}
+
+	if( !m_bBackground )
+	{
+		Flush();
+	}
+}
+
+
+//**********************************************************************
+//	Refresh
+//----------------------------------------------------------------------
+//	sends the first group of dirty characters with the same font
+//	of the next dirty line to the display.
+//	Returns false if the display shows the whole buffer.
+//
+bool DisplayBufferClass::Refresh( void )
+{
+	char		archText[ DISPLAY_COLUMNS + 1 ];
+	uint16_t	uiDirty;
+	uint8_t		usLine		= m_usRefresh;
+	uint8_t		usStart		= 0;
+	uint8_t		usColumn;
+	uint8_t		usCount		= 0;
+	bool		bInverse;
+
+	//--------------------------------------------------------------
+	//	next line with dirty characters
+	//
+	while( 0x0000 == m_aruiDirty[ usLine ] )
+	{
+		if( DISPLAY_LINES <= ++usCount )
+		{
+			return( false );
+		}
+
+		usLine = (usLine + 1) % DISPLAY_LINES;
+	}
+
+	m_usRefresh	= usLine;
+	uiDirty		= m_aruiDirty[ usLine ];
+
+	while( !(uiDirty & (((uint16_t)1) << usStart)) )
+	{
+		usStart++;
+	}
+
+	bInverse	= (m_aruiInverse[ usLine ] >> usStart) & 0x0001;
+	usColumn	= usStart;
+
+	//--------------------------------------------------------------
+	//	group of dirty characters with the same font
+	//
+	while(		(DISPLAY_COLUMNS > usColumn)
+			&&	(uiDirty & (((uint16_t)1) << usColumn))
+			&&	(bInverse == ((m_aruiInverse[ usLine ] >> usColumn) & 0x0001))	)
+	{
+		archText[ usColumn - usStart ] = m_archCell[ usLine ][ usColumn ];
+
+		m_aruiDirty[ usLine ] &= ~(((uint16_t)1) << usColumn);
+
+		usColumn++;
+	}
+
+	archText[ usColumn - usStart ] = '\0';
+
+	g_clDisplay.SetCursor( usLine, usStart );
+	g_clDisplay.SetInverseFont( bInverse );
+	g_clDisplay.Print( archText );
+	g_clDisplay.SetInverseFont( false );
+
+	return( true );
+}
+
+
+//**********************************************************************
+//	Flush
+//----------------------------------------------------------------------
+//	sends all dirty characters to the display
+//
+void DisplayBufferClass::Flush( void )
+{
+	while( Refresh() )
+	{
+	}
+}
+
+
+//**********************************************************************
+//	PutChar
+//----------------------------------------------------------------------
+//	A character is only marked dirty if the character or its font
+//	differ from the buffer.
+//
+void DisplayBufferClass::PutChar( char chChar )
+{
+	uint16_t	uiMask;
+	bool		bInverse;
+
+	if( '\n' == chChar )
+	{
+		m_usLine++;
+		m_usColumn = 0;
+
+		return;
+	}
+
+	if( (DISPLAY_LINES > m_usLine) && (DISPLAY_COLUMNS > m_usColumn) )
+	{
+		uiMask		= ((uint16_t)1) << m_usColumn;
+		bInverse	= (0x0000 != (m_aruiInverse[ m_usLine ] & uiMask));
+
+		if( (chChar != m_archCell[ m_usLine ][ m_usColumn ]) || (bInverse != m_bInverse) )
+		{
+			m_archCell[ m_usLine ][ m_usColumn ] = chChar;
+
+			if( m_bInverse )
+			{
+				m_aruiInverse[ m_usLine ] |= uiMask;
+			}
+			else
+			{
+				m_aruiInverse[ m_usLine ] &= ~uiMask;
+			}
+
+			m_aruiDirty[ m_usLine ] |= uiMask;
+		}
+	}
+
+	m_usColumn++;
+}
+
+
+//**************************************************************************
+//**************************************************************************
+#endif	//	DEBUGGING_PRINTOUT
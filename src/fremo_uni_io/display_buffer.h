@@ -0,0 +1,106 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		DisplayBufferClass
+//#
+//#	This class keeps the content of the OLED display in RAM
+//#	(DISPLAY_LINES lines with DISPLAY_COLUMNS characters each).
+//#	'Print()', 'ClearLine()', ... only change the buffer and mark
+//#	the changed characters as dirty. So they cost no time on the
+//#	I2C bus, even if they are called from the Loconet callbacks.
+//#
+//#	'Refresh()' is called in each pass of 'loop()'. It sends one
+//#	group of dirty characters of one line to the display, so the
+//#	display follows the buffer in the background.
+//#
+//#	Until 'SetBackground( true )' is called (end of 'setup()'),
+//#	each function sends its changes at once, so the texts of the
+//#	start up are shown during the waits of 'setup()'.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <Arduino.h>
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+#define DISPLAY_LINES		8
+#define DISPLAY_COLUMNS		16		//	one bit per column in an uint16_t
+
+
+//==========================================================================
+//
+//		C L A S S   D E F I N I T I O N S
+//
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////
+//	CLASS:	DisplayBufferClass
+//
+class DisplayBufferClass
+{
+	public:
+		DisplayBufferClass();
+
+		void Init( void );
+		void Clear( void );
+		void ClearLine( uint8_t usLine );
+		void SetCursor( uint8_t usLine, uint8_t usColumn );
+		void SetInverseFont( bool bInverse );
+		void Print( const char *pchText );
+		void Print( const __FlashStringHelper *pText );
+
+		bool Refresh( void );
+		void Flush( void );
+
+		inline void SetBackground( bool bBackground )
+		{
+			m_bBackground = bBackground;
+		};
+
+	private:
+		//----------------------------------------------------------
+		//	m_aruiDirty		changed characters not yet sent
+		//	m_aruiInverse	characters with inverse font
+		//	m_usRefresh		line that is sent by 'Refresh()'
+		//
+		char		m_archCell[ DISPLAY_LINES ][ DISPLAY_COLUMNS ];
+		uint16_t	m_aruiDirty[ DISPLAY_LINES ];
+		uint16_t	m_aruiInverse[ DISPLAY_LINES ];
+		uint8_t		m_usLine;
+		uint8_t		m_usColumn;
+		uint8_t		m_usRefresh;
+		bool		m_bInverse;
+		bool		m_bBackground;
+
+		void PutChar( char chChar );
+};
+
+
+//==========================================================================
+//
+//		E X T E R N   G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+extern DisplayBufferClass	g_clDisplayBuffer;
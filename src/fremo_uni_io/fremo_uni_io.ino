@@ -18,8 +18,8 @@
 //	The main version is defined by PLATINE_VERSION (compile_options.h)
 //
 //#define VERSION_MAIN	1
-#define	VERSION_MINOR	4
-#define VERSION_HOTFIX	0
+#define	VERSION_MINOR	7
+#define VERSION_HOTFIX	13
 
 #define VERSION_NUMBER		((PLATINE_VERSION * 10000) + (VERSION_MINOR * 100) + VERSION_HOTFIX)
 
@@ -30,6 +30,262 @@
 //#
 //#-------------------------------------------------------------------------
 //#
+//#	Version: x.07.13	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	input changes, Loconet messages, LNCV programming and
+//#			the loop time can be traced over the USB serial
+//#			interface (compile option USB_TRACE, see usb_trace.h)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.07.12	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the Loconet callbacks only record debug events, they are
+//#			shown when there is nothing to send (DEBUGGING_PRINTOUT)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.07.11	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the debug texts are written into a display buffer, after
+//#			'setup()' the display follows in the background, one
+//#			group of changed characters in each pass of 'loop()'
+//#			(DEBUGGING_PRINTOUT, see display_buffer.h)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.07.10	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the status on the display is only updated where it has
+//#			changed (DEBUGGING_PRINTOUT)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.07.09	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the phases of 'loop()' can be timed
+//#			(compile option LOOP_PROFILING, see loop_profiler.h)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.07.08	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	runtime counters as read-only LNCVs 100 .. 114
+//#			(packets received and matched, messages sent and failed,
+//#			send queue, suppressed messages, uptime, max loop time
+//#			and the times of the start up phases)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.07.07	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new LNCV 6: report window in ms
+//#			the same report (address, message type and direction)
+//#			is not sent again within this time, e.g. by another
+//#			input with the same address
+//#			default 50 ms, also for boards of older versions
+//#			'0': no window
+//#		-	the echoes of our own messages are dropped, our own
+//#			outputs follow a message when it is sent
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.07.06	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new LNCV 5: slot width in ms for the broadcast of the
+//#			inputs after power up
+//#			Each board waits (module address % 32) * slot width
+//#			before it sends the state of its inputs, so not all
+//#			boards of a layout send at the same time.
+//#			The slot width is at least one burst of the board
+//#			(16 * 2 * send delay), default 320 ms, also for
+//#			boards of older versions. '0': no waiting
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.07.05	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new compile option FAST_BOOT
+//#			the fixed waits in 'setup()' are replaced by waiting
+//#			for the EEPROM and for stable inputs
+//#		-	the time of each start up phase is kept in
+//#			'g_aruiBootTime[]' (see boot_phases.h)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.07.04	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	no reset at the end of the programming mode, the new
+//#			configuration is taken over while running
+//#			only the pins whose role or address has changed are
+//#			configured again and reported on the Loconet
+//#			new function
+//#				ApplyConfiguration()
+//#			removed function
+//#				resetFunc()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.07.03	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the LNCVs are read from the EEPROM with one block read
+//#			and checked by a CRC, that is stored behind the LNCVs
+//#		-	LNCVs with a wrong CRC are replaced by the default
+//#			values, the red LED flashes until the board is
+//#			programmed again
+//#		-	LNCVs of older versions (without CRC) are taken over
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.07.02	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the state of the outputs is stored in a journal in the
+//#			EEPROM (behind the LNCVs), each change goes into the
+//#			next entry of the journal to spread the EEPROM writes
+//#		-	at startup the outputs are set at once to the state
+//#			stored in the journal, no Loconet message is needed
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.07.01	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	all LNCVs are held in RAM, reading an LNCV does not
+//#			access the EEPROM
+//#		-	writing an LNCV does not wait for the EEPROM, the EEPROM
+//#			ready interrupt writes the changed LNCVs in the background
+//#		-	in programming mode the red LED is on as long as LNCVs
+//#			are not yet written into the EEPROM
+//#		-	all LNCVs are written before the reset at the end of
+//#			the programming mode
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.07.00	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new LNCVs 51 .. 66: number of debounce samples for each
+//#			I/O pin, value = fall * 10 + rise
+//#				fall	samples for a falling edge (pin goes low)
+//#				rise	samples for a rising edge (pin goes high)
+//#			1 .. 7 samples each, 0 = default (4 samples)
+//#			e.g. 17: fast ON (occupied) and slow OFF (free)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.06.02	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	all inputs are debounced by one 16 bit debouncer
+//#			(DebounceClass is a template over the word type)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.06.01	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	optional edge capture for the inputs on PB4 .. PB7
+//#			(compile option INPUT_EDGE_CAPTURE)
+//#			an input is taken over EDGE_SETTLE_TIME ms after its
+//#			last edge instead of after four samples
+//#		-	the off delay is counted from the time the input has
+//#			changed (with edge capture: time of the first edge)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.06.00	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the inputs are sampled in a timer interrupt every
+//#			INPUT_SAMPLE_TIME ms (io_control.h), the sampling no
+//#			longer depends on the time a loop takes
+//#		-	'CheckIOState()' is only called if an input has changed
+//#		-	the check of the off delay timers is done in the new
+//#			function 'CheckOffDelays()'
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.05.06	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	'CheckLnState()' sets all changed outputs at once,
+//#			each port is written only once
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.05.05	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	'GetIOState()' reads all inputs with one call
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.05.04	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the pinout of the boards is defined at compile time
+//#			(board_pinout.h), the mapping tables in RAM are gone
+//#
+//#	Bugfix:
+//#		-	the LEDs used the wrong port pins
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.05.03	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the off delay timers are handled by the new timer service
+//#			only the timer that expires next will be checked in
+//#			each loop
+//#
+//#	Bugfix:
+//#		-	the timers did not work after an overflow of millis()
+//#			(after 49.7 days)
+//#		-	an off delay timer with a deadline of 0 was ignored
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.05.02	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add benchmark for the functions called in each loop
+//#			(compile option BENCHMARK_HOT_PATH)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.05.01	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	received Loconet messages are checked with an address index
+//#			instead of checking all I/O pins
+//#
+//#	Bugfix:
+//#		-	inverted outputs sharing one address with other outputs
+//#			changed the state of these other outputs
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	Version: x.05.00	vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	Loconet messages are sent via a send queue
+//#			the loop is no longer blocked by the send delay time
+//#		-	show the maximum fill level of the send queue
+//#
+//#-------------------------------------------------------------------------
+//#
 //#	Version: x.04.00	vom: 04.02.2023
 //#
 //#	Implementation:
@@ -160,9 +416,18 @@
 #include "debugging.h"
 #endif
 
+#ifdef BENCHMARK_HOT_PATH
+#include "benchmark.h"
+#endif
+
+#include "boot_phases.h"
 #include "io_control.h"
 #include "lncv_storage.h"
+#include "loop_profiler.h"
 #include "my_loconet.h"
+#include "state_journal.h"
+#include "timer_service.h"
+#include "usb_trace.h"
 
 
 //==========================================================================
@@ -171,7 +436,6 @@
 //
 //==========================================================================
 
-#define READ_INPUTS_TIME		20
 #define PRINT_STATUS_TIME		250
 
 
@@ -181,12 +445,18 @@
 //
 //==========================================================================
 
-uint32_t	g_ulReadInputTimer					= 0L;
 uint32_t	g_ulPrintStatusTimer				= 0L;
-uint32_t	g_arulOffDelayTimer[ IO_NUMBERS ];
 uint16_t	g_uiLnState;
 uint16_t	g_uiIOState;
 bool		g_bIsProgMode;
+uint16_t	g_aruiBootTime[ BOOT_PHASE_COUNT ];
+
+//----------------------------------------------------------------------
+//	the state of the inputs after power up is sent at
+//	g_ulBroadcastTime (time slot of the board)
+//
+uint32_t	g_ulBroadcastTime;
+bool		g_bBroadcastPending;
 
 
 //==========================================================================
@@ -195,20 +465,12 @@ bool		g_bIsProgMode;
 //
 //==========================================================================
 
-//**********************************************************************
-//	resetFunc
-//----------------------------------------------------------------------
-//	This function will reset the hole processor because by calling the
-//	function the program will jump to the hardware reset vector.
-//
-void (*resetFunc)( void ) = 0;
-
-
 //**************************************************************************
 //	CheckLnState
 //--------------------------------------------------------------------------
 //	The function will check the changes in the Loconet state and 
 //	will switch the output(s) accordingly
+//	All outputs of one port will change at the same time.
 //
 void CheckLnState( uint16_t uiNewLnState )
 {
@@ -216,9 +478,6 @@ void CheckLnState( uint16_t uiNewLnState )
 	//	get difference between old and actual state ...
 	//
 	uint16_t	uiDiff		= g_uiLnState ^ uiNewLnState;
-	uint16_t	uiMask		= 0x0001;
-	uint8_t		usDir		= 0;
-	uint8_t		idx			= 0;
 
 	//------------------------------------------------------------------
 	//	... but handle outputs only
@@ -226,32 +485,11 @@ void CheckLnState( uint16_t uiNewLnState )
 	uiDiff &= g_clLncvStorage.GetAsOutputs();
 
 	//------------------------------------------------------------------
-	//	now for each change set/clear the appropriate IO pin
+	//	now set/clear all changed IO pins at once
 	//
-	while( 0 < uiDiff )
+	if( uiDiff )
 	{
-		if( uiDiff & uiMask )
-		{
-			if( uiNewLnState & uiMask )
-			{
-				usDir = 1;
-			}
-			else
-			{
-				usDir = 0;
-			}
-
-			g_clControl.SetOutput( idx, usDir );
-
-			//----------------------------------------------------------
-			//	this change was handled,
-			//	so clear the corresponding bit
-			//
-			uiDiff &= ~uiMask;
-		}
-
-		idx++;
-		uiMask <<= 1;
+		g_clControl.SetOutputs( uiNewLnState, uiDiff );
 	}
 
 	g_uiLnState = uiNewLnState;
@@ -261,30 +499,12 @@ void CheckLnState( uint16_t uiNewLnState )
 //**************************************************************************
 //	GetIOState
 //--------------------------------------------------------------------------
+//	returns the debounced state of all inputs
+//	(outputs are always '0')
 //
 uint16_t GetIOState( void )
 {
-	uint16_t	uiInputs	= g_clLncvStorage.GetAsInputs();
-	uint16_t	uiIOState	= 0x0000;
-	uint16_t	uiMask		= 0x0001;
-
-	//------------------------------------------------------------------
-	//	get IO states
-	//
-	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
-	{
-		if( uiInputs & uiMask )
-		{
-			if( g_clControl.IsInputSet( idx ) )
-			{
-				uiIOState |= uiMask;
-			}
-		}
-
-		uiMask <<= 1;
-	}
-	
-	return( uiIOState );
+	return( g_clControl.GetInputs() );
 }
 
 
@@ -293,10 +513,10 @@ uint16_t GetIOState( void )
 //--------------------------------------------------------------------------
 //	The function will check the changes in the IO state and 
 //	will send the appropriate Loconet messages accordingly
+//	or start the off delay timer
 //
 void CheckIOState( uint16_t uiNewIOState )
 {
-	uint32_t	ulOffTimer	= 0L;
 	uint16_t	uiOffDelay	= 0;
 
 	//------------------------------------------------------------------
@@ -311,6 +531,8 @@ void CheckIOState( uint16_t uiNewIOState )
 	//
 	uiDiff &= g_clLncvStorage.GetAsInputs();
 
+	TRACE_INPUT( uiDiff, uiNewIOState & g_clLncvStorage.GetAsInputs() );
+
 	//------------------------------------------------------------------
 	//	now for each change send the appropriate Loconet message
 	//
@@ -325,9 +547,9 @@ void CheckIOState( uint16_t uiNewIOState )
 				//	and stay in 'ON' state
 				//	else send the Loconet message for IO pin is ON
 				//
-				if( g_arulOffDelayTimer[ idx ] )
+				if( g_clTimerService.IsRunning( idx ) )
 				{
-					g_arulOffDelayTimer[ idx ] = 0L;
+					g_clTimerService.Stop( idx );
 				}
 				else
 				{
@@ -340,13 +562,15 @@ void CheckIOState( uint16_t uiNewIOState )
 				//------------------------------------------------------
 				//	the IO pin has changed to OFF, so if there is a
 				//	delay time configured start the delay timer
+				//	(counted from the time the input has changed)
 				//	else send the loconet message for IO pin is OFF
 				//
 				uiOffDelay = g_clLncvStorage.GetIOOffDelay( idx );
 				
 				if( uiOffDelay )
 				{
-					g_arulOffDelayTimer[ idx ] = millis() + uiOffDelay;
+					g_clTimerService.StartAt(	idx, g_clControl.GetChangeTime( idx ),
+												uiOffDelay								);
 				}
 				else
 				{
@@ -367,26 +591,76 @@ void CheckIOState( uint16_t uiNewIOState )
 	}
 
 	g_uiIOState = uiNewIOState;
-	
-	//------------------------------------------------------------------
-	//	now check if any delay timer is lapsed and if so stop the timer
-	//	and send the loconet message for IO pin OFF for that pin
-	//
-	uiMask = 0x0001;
+}
+
+
+//**************************************************************************
+//	CheckOffDelays
+//--------------------------------------------------------------------------
+//	The function checks if any delay timer is lapsed and if so
+//	sends the loconet message for IO pin OFF for that pin
+//	(the timer service delivers the lapsed timers in order
+//	and stops them)
+//
+void CheckOffDelays( void )
+{
+	uint8_t	usTimer = g_clTimerService.GetExpired( millis() );
 
-	for( idx = 0 ; idx < IO_NUMBERS ; idx++ )
+	while( TIMER_NONE != usTimer )
 	{
-		ulOffTimer = g_arulOffDelayTimer[ idx ];
+		g_clMyLoconet.SendMessage(	g_clLncvStorage.GetIOAddress( usTimer ),
+									((uint16_t)1) << usTimer, 0					);
 
-		if( ulOffTimer && (millis() > ulOffTimer) )
-		{
-			g_arulOffDelayTimer[ idx ] = 0L;
+		usTimer = g_clTimerService.GetExpired( millis() );
+	}
+}
+
+
+//**************************************************************************
+//	ApplyConfiguration
+//--------------------------------------------------------------------------
+//	The function takes over the LNCVs at the end of the programming
+//	mode without a reset.
+//	Only the pins whose role or address has changed are handled:
+//		-	outputs are switched off (the state of the new address
+//			is not known yet)
+//		-	for inputs the actual state is sent
+//	the trick here is the same as in setup(): the old state value
+//	is set as inverted actual state for the changed inputs
+//
+void ApplyConfiguration( void )
+{
+	uint16_t	uiChanged	= g_clLncvStorage.Reload();
+	uint16_t	uiIOState;
+	uint16_t	uiMask		= 0x0001;
 
-			g_clMyLoconet.SendMessage( g_clLncvStorage.GetIOAddress( idx ),	uiMask, 0 );
+	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
+	{
+		g_clControl.SetSamples(	idx, g_clLncvStorage.GetIOFallSamples( idx ),
+										g_clLncvStorage.GetIORiseSamples( idx )	);
+
+		if( uiChanged & uiMask )
+		{
+			g_clTimerService.Stop( idx );
 		}
 
 		uiMask <<= 1;
 	}
+
+	g_clControl.Reconfigure( g_clLncvStorage.GetAsOutputs() );
+	g_clMyLoconet.ForgetReports( uiChanged );
+
+	//----	outputs  ---------------------------------------------------
+	g_clMyLoconet.SetInputStatus( g_clMyLoconet.GetInputStatus() & ~uiChanged );
+
+	CheckLnState( g_clMyLoconet.GetInputStatus() );
+
+	//----	inputs  ----------------------------------------------------
+	uiIOState		 = GetIOState();
+	g_uiIOState		&= ~uiChanged;
+	g_uiIOState		|= ~uiIOState & uiChanged;
+
+	CheckIOState( uiIOState );
 }
 
 
@@ -410,27 +684,70 @@ void setup()
 	g_clDebugging.PrintInfoLine( infoLineInit );
 #endif
 
+#ifdef USB_TRACE
+	g_clUsbTrace.Init( VERSION_NUMBER );
+#endif
+
 	//----	LNCV: Check and Init  --------------------------------------
 	g_clLncvStorage.CheckEEPROM( VERSION_NUMBER );
-	
+
+#ifdef FAST_BOOT
+	g_clLncvStorage.Flush();
+#else
 	delay( 500 );
+#endif
+
+	BOOT_PHASE( BOOT_PHASE_EEPROM );
 
 	g_clLncvStorage.Init();
 
+#ifndef FAST_BOOT
 	delay( 500 );
+#endif
+
+	BOOT_PHASE( BOOT_PHASE_CONFIG );
 
 	uiAsOutput = g_clLncvStorage.GetAsOutputs();
 
 	//----	other inits  -----------------------------------------------
+	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
+	{
+		g_clControl.SetSamples(	idx, g_clLncvStorage.GetIOFallSamples( idx ),
+										g_clLncvStorage.GetIORiseSamples( idx )	);
+	}
+
 	g_clControl.Init( uiAsOutput );
 	g_clMyLoconet.Init();
 
-	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
+	BOOT_PHASE( BOOT_PHASE_INPUTS );
+
+	if( g_clLncvStorage.IsImageRejected() )
 	{
-		g_arulOffDelayTimer[ idx ] = 0L;
+		g_clControl.RedLedFlash();
 	}
 
+	g_clTimerService.Init();
+
+	//------------------------------------------------------------------
+	//	restore the state of the outputs from the journal and
+	//	set the output pins at once
+	//	the trick here is to set the old state value as inverted
+	//	actual state to get all outputs set
+	//
+	if( g_clStateJournal.Restore( &uiLnStateStart ) )
+	{
+		g_clMyLoconet.SetInputStatus( uiLnStateStart & uiAsOutput );
+	}
+
+	uiLnStateStart	 = g_clMyLoconet.GetInputStatus();	//	actual state
+	g_uiLnState		 = ~uiLnStateStart;	//	trick to set all pins
+	g_uiLnState		&= uiAsOutput;		//	but only for outputs
+
+	CheckLnState( uiLnStateStart );		//	set output pins
+
+#ifndef FAST_BOOT
 	delay( 100 );
+#endif
 
 	//----	Show Configuration  ----------------------------------------
 #ifdef DEBUGGING_PRINTOUT
@@ -439,7 +756,9 @@ void setup()
 										g_clLncvStorage.GetAsSensor(),
 										g_clLncvStorage.GetIsInverse()	);
 
+#ifndef FAST_BOOT
 	delay( 2000 );
+#endif
 #endif
 
 	//----	Prepare Display  -------------------------------------------
@@ -449,25 +768,32 @@ void setup()
 #endif
 
 	//------------------------------------------------------------------
-	//	get the actual input and output state and set the I/O pins
-	//	respective send the appropriate LN messages
-	//	the trick here is to set the old state values as inverted
-	//	actual states to get all I/Os set and LN messages send
+	//	get the actual input state, the appropriate LN messages will
+	//	be sent by 'loop()' in the time slot of the board
+	//	the trick here is to set the old state value as inverted
+	//	actual state to get all LN messages send
 	//
 	uiIOStateStart	 = GetIOState();	//	actual state
 	g_uiIOState		 = ~uiIOStateStart;	//	trick to send all messages
 	g_uiIOState		&= ~uiAsOutput;		//	but only for inputs
 
-	CheckIOState( uiIOStateStart );		//	send messages
-	
-	uiLnStateStart	 = g_clMyLoconet.GetInputStatus();	//	actual state
-	g_uiLnState		 = ~uiLnStateStart;	//	trick to set all pins
-	g_uiLnState		&= uiAsOutput;		//	but only for outputs
+	g_ulBroadcastTime	= millis() + g_clLncvStorage.GetBroadcastDelay();
+	g_bBroadcastPending	= true;
 
-	CheckLnState( uiLnStateStart );		//	set output pins
+	BOOT_PHASE( BOOT_PHASE_READY );
 
-	//----	Start Read Timer  ------------------------------------------
-	g_ulReadInputTimer = millis() + READ_INPUTS_TIME;
+#ifdef DEBUGGING_PRINTOUT
+	g_clDebugging.PrintBootTimes( g_aruiBootTime );
+	g_clDebugging.DisplayInBackground();
+#endif
+
+#ifdef BENCHMARK_HOT_PATH
+	g_clBenchmark.Run( VERSION_NUMBER );
+#endif
+
+#ifdef LOOP_PROFILING
+	g_clLoopProfiler.Init();
+#endif
 }
 
 
@@ -477,26 +803,58 @@ void setup()
 //
 void loop()
 {
+	uint32_t	ulLoopStart	= micros();
+	uint32_t	ulLoopTime;
+	uint16_t	uiIOState;
+
+	PROFILE_START();
+
 	//==================================================================
 	//	Read Inputs
 	//	-	Loconet messages
-	//	-	Input signals
+	//	-	Input signals (sampled by the timer interrupt)
 	//
 	g_clMyLoconet.CheckForMessage();
 
-	if( millis() > g_ulReadInputTimer )
-	{
-		g_ulReadInputTimer = millis() + READ_INPUTS_TIME;
+	PROFILE_PHASE( PROFILE_PHASE_MESSAGE );
 
-		g_clControl.ReadInputs();
-	}
+	g_clControl.CheckLeds();
 
 	//==================================================================
 	//	depending of input pins and received LN messages
 	//	set output pins and send LN messages
 	//
 	CheckLnState( g_clMyLoconet.GetInputStatus() );
-	CheckIOState( GetIOState() );
+
+	g_clStateJournal.Store( g_uiLnState );
+
+	PROFILE_PHASE( PROFILE_PHASE_LN_STATE );
+
+	//------------------------------------------------------------------
+	//	after power up the inputs are sampled but not sent
+	//	until the time slot of the board has come
+	//
+	if( g_bBroadcastPending )
+	{
+		if( IsTimeOver( millis(), g_ulBroadcastTime ) )
+		{
+			g_bBroadcastPending = false;
+
+			CheckIOState( GetIOState() );
+		}
+	}
+	else if( g_clControl.GetChangedInputs( &uiIOState ) )
+	{
+		CheckIOState( uiIOState );
+	}
+
+	CheckOffDelays();
+
+	PROFILE_PHASE( PROFILE_PHASE_IO_STATE );
+
+	g_clMyLoconet.ProcessSendQueue();
+
+	PROFILE_PHASE( PROFILE_PHASE_SEND );
 
 	//------------------------------------------------------------------
 	//	Programmier-Modus
@@ -505,7 +863,13 @@ void loop()
 	{
 		if( g_bIsProgMode )
 		{
-			resetFunc();
+			//----	the EEPROM is written in the background  --------
+			g_bIsProgMode = false;
+
+			ApplyConfiguration();
+
+			g_clControl.GreenLedOff();
+			g_clControl.RedLedOff();
 		}
 		else
 		{
@@ -515,17 +879,62 @@ void loop()
 		}
 	}
 
+	//------------------------------------------------------------------
+	//	while programming the red LED shows that LNCVs are not yet
+	//	written into the EEPROM (do not switch off the power)
+	//
+	if( g_bIsProgMode )
+	{
+		if( 0 < g_clLncvStorage.GetPendingWrites() )
+		{
+			g_clControl.RedLedOn();
+		}
+		else
+		{
+			g_clControl.RedLedOff();
+		}
+	}
+
+	PROFILE_PHASE( PROFILE_PHASE_PROG );
+
 
 	//==================================================================
 	//	print actual status
 	//
 #ifdef DEBUGGING_PRINTOUT
-	if( millis() > g_ulPrintStatusTimer )
+	if( IsTimeOver( millis(), g_ulPrintStatusTimer ) )
 	{
 		g_ulPrintStatusTimer = millis() + PRINT_STATUS_TIME;
 
 		g_clDebugging.PrintStatus(	g_clLncvStorage.GetAsOutputs(),
-									g_uiLnState, g_uiIOState		);
+									g_uiLnState, g_uiIOState,
+									g_clMyLoconet.GetSendQueueMax()	);
 	}
+
+	//------------------------------------------------------------------
+	//	the debug events are shown in idle time only
+	//
+	if( 0 == g_clMyLoconet.GetSendQueueCount() )
+	{
+		g_clDebugging.ShowNextEvent();
+	}
+
+	g_clDebugging.RefreshDisplay();
 #endif
+
+	//------------------------------------------------------------------
+	//	hand over the trace records to the USB interface
+	//
+	TRACE_FLUSH();
+
+	PROFILE_PHASE( PROFILE_PHASE_STATUS );
+
+	//------------------------------------------------------------------
+	//	keep the max loop time for the runtime counters
+	//
+	ulLoopTime = micros() - ulLoopStart;
+
+	g_clMyLoconet.SetLoopTime( ulLoopTime );
+
+	TRACE_LOOP( ulLoopTime );
 }
@@ -9,35 +9,143 @@
 //#		-	check digital inputs
 //#		-	set digital outputs
 //#
-//#	The assignment of the IO pins to the port pins is shown
-//#	in the following table:
-//#		Head	Pin		IO Pin	Port Pin
-//#		SV 6	6		15			PF 0
-//#		SV 6	5		14			PF 1
-//#		SV 7	6		13			PF 4
-//#		SV 7	5		12			PF 5
-//#		SV 8	6		11			PF 6
-//#		SV 8	5		10			PF 7
-//#		SV 1	6		 9			PB 5
-//#		SV 1	5		 8			PB 6
-//#		SV 3	6		 7			PC 6
-//#		SV 3	5		 6			PC 7
-//#		SV 5	6		 5			PE 2
-//#		SV 5	5		 4			PB 4
-//#		SV 2	6		 3			PB 7
-//#		SV 2	5		 2			PD 7
-//#		SV 4	6		 1			PD 5
-//#		SV 4	5		 0			PD 6
-//#
-//#	To simplify the program code the mapping is done with the help
-//#	of a few arrays. The trick is to use the universal pin number (IO pin)
-//#	as array index for the different mapping arrays.
-//#	The following mappings are needed:
-//#		-	pin of port
-//#		-	input  mask for data direction
-//#		-	output mask for data direction
-//#		-	read an input
-//#		-	set an output
+//#	The assignment of the IO pins to the port pins is described
+//#	in board_pinout.h for each board version.
+//#	The pin codes of the universal pins (IO pins) are stored in
+//#	flash memory, the pins are reached by the port ID and the mask
+//#	of the pin:
+//#		-	input  mask for data direction (per port)
+//#		-	output mask for data direction (per port)
+//#	To read all inputs at once, the state of each port is mapped
+//#	to the universal pins by tables (one per port and nibble).
+//#	All universal pins are debounced by one debouncer.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	14		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	BENCHMARK_HOT_PATH: in a dry run SetOutputs() does not
+//#			switch the outputs, the benchmark must not move the
+//#			turnouts and signals of the layout
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	13		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	SetOutputs() uses IOToPort() too
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	12		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	FAST_BOOT: Init() takes over the levels of the inputs
+//#			as soon as they are stable instead of waiting for
+//#			INIT_READ_INPUT_COUNT samples
+//#			new function
+//#				ReadLevels()	(first part of 'SampleInputs()')
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	11		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new function Reconfigure()
+//#			only the pins that change between input and output
+//#			are configured again, the sampling keeps running
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	10		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the number of samples for a falling and a rising edge
+//#			can be set for each pin
+//#			new function
+//#				SetSamples()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	9		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the levels of all universal pins are gathered first and
+//#			debounced in one pass by one 16 bit debouncer instead
+//#			of five 8 bit debouncers (one per port)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	8		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	optional edge capture (compile option INPUT_EDGE_CAPTURE)
+//#			The pin change interrupt stores each edge of the inputs
+//#			on PB4 .. PB7 with its time in a ring. The timer interrupt
+//#			takes over the level of a pin as soon as no edge was seen
+//#			for EDGE_SETTLE_TIME ms, instead of waiting for four
+//#			samples.
+//#			new functions
+//#				EdgeCapture()
+//#				CheckEdges()
+//#				GetChangeTime()
+//#				PublishInputs()	(second part of 'SampleInputs()')
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	7		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the inputs are sampled in the Timer 0 compare B interrupt
+//#			every INPUT_SAMPLE_TIME ms, independent of 'loop()'
+//#			The interrupt publishes the debounced state, the main
+//#			loop reads it without blocking the interrupts.
+//#			new functions
+//#				SampleTick()
+//#				SampleInputs()
+//#				GetChangedInputs()
+//#				CheckLeds()		(LED part of the old 'ReadInputs()')
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	6		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	set several outputs at once
+//#			new function
+//#				SetOutputs()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	5		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	read all inputs with one call
+//#			new function
+//#				GetInputs()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	4		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the pinout is defined at compile time in board_pinout.h
+//#			the mapping arrays in RAM and the function pointers
+//#			are replaced by a pin code table in flash memory and
+//#			one debouncer array indexed by the port ID
+//#
+//#	Bugfix:
+//#		-	the LEDs were switched with a double _BV(), so the
+//#			wrong port pins were used
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	3		vom: 17.10.2026
+//#
+//#	Bugfix:
+//#		-	the LED flash timer did not work after an overflow
+//#			of millis() (after 49.7 days)
 //#
 //#-------------------------------------------------------------------------
 //#
@@ -65,22 +173,13 @@
 #include "compile_options.h"
 
 #include <Arduino.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 
+#include "board_pinout.h"
 #include "io_control.h"
 #include "debounce.h"
-
-
-//==========================================================================
-//
-//		F U N C T I O N   D E C L A R A T I O N
-//
-//==========================================================================
-
-uint8_t GetKeyStatePortB( uint8_t usMask );
-uint8_t GetKeyStatePortC( uint8_t usMask );
-uint8_t GetKeyStatePortD( uint8_t usMask );
-uint8_t GetKeyStatePortE( uint8_t usMask );
-uint8_t GetKeyStatePortF( uint8_t usMask );
+#include "timer_service.h"
 
 
 //==========================================================================
@@ -89,111 +188,17 @@ uint8_t GetKeyStatePortF( uint8_t usMask );
 //
 //==========================================================================
 
-#define	INIT_READ_INPUT_COUNT	6
+#define	INIT_READ_INPUT_COUNT	(DEBOUNCE_MAX_SAMPLES + 2)
 #define FLASH_TIME				250
 
-/*
-#define MASK_PORT_BIT_0			0x01
-#define MASK_PORT_BIT_1			0x02
-#define MASK_PORT_BIT_2			0x04
-#define MASK_PORT_BIT_3			0x08
-#define MASK_PORT_BIT_4			0x10
-#define MASK_PORT_BIT_5			0x20
-#define MASK_PORT_BIT_6			0x40
-#define MASK_PORT_BIT_7			0x80
-*/
-
-
-//---------------------------------------------------------------------
-//	Port B			V1				V2
-//		PB0		LED GREEN		Relais
-//		PB1		LED RED			LED RED
-//		PB2		N/A				LED GREEN
-//		PB3		N/A				N/A
-//		PB4		Input Output	Input Output
-//		PB5		Input Output	Input Output
-//		PB6		Input Output	Input Output
-//		PB7		Input Output	Input Output
-//
-#if PLATINE_VERSION == 1
-
-	#define LED_GREEN		_BV( 0 )
-
-#else
-
-	#define RELAIS			_BV( 0 )
-	#define LED_GREEN		_BV( 2 )
 
-#endif
-
-#define LED_RED				_BV( 1 )
-
-
-//---------------------------------------------------------------------
-//	Port C
-//		PC0		N/A
-//		PC1		N/A
-//		PC2		N/A
-//		PC3		N/A
-//		PC4		N/A
-//		PC5		N/A
-//		PC6		Input Output
-//		PC7		Input Output
-//
-
-
-//---------------------------------------------------------------------
-//	Port D
-//		PD0		N/A
-//		PD1		N/A
-//		PD2		N/A
-//		PD3		N/A
-//		PD4		N/A
-//		PD5		Input Output
-//		PD6		Input Output
-//		PD7		Input Output
-//
-
-
-//---------------------------------------------------------------------
-//	Port E
-//		PE0		N/A
-//		PE1		N/A
-//		PE2		Input Output
-//		PE3		N/A
-//		PE4		N/A
-//		PE5		N/A
-//		PE6		N/A
-//		PE7		N/A
-//
-
-
-//---------------------------------------------------------------------
-//	Port F
-//		PF0		Input Output
-//		PF1		Input Output
-//		PF2		N/A
-//		PF3		N/A
-//		PF4		Input Output
-//		PF5		Input Output
-//		PF6		Input Output
-//		PF7		Input Output
-//
-
-
-//==========================================================================
-//
-//		M A C R O S
+//----------------------------------------------------------------------
+//	the LEDs and the relais must not use an I/O pin
 //
-//==========================================================================
-
-#ifndef cbi
-#define cbi(sfr, bit) (_SFR_BYTE(sfr) &= ~_BV(bit))
-#endif
-
-#ifndef sbi
-#define sbi(sfr, bit) (_SFR_BYTE(sfr) |= _BV(bit))
-#endif
+static_assert(		!IsIOPinCode( Board::LedGreen )
+				&&	!IsIOPinCode( Board::LedRed )
+				&&	!IsIOPinCode( Board::Relais ),
+				"LED or relais pin is used as I/O pin"		);
 
 
 //==========================================================================
@@ -204,167 +209,159 @@ uint8_t GetKeyStatePortF( uint8_t usMask );
 
 IO_ControlClass		g_clControl	= IO_ControlClass();
 
-DebounceClass		g_clPortB( 0x00 );
-DebounceClass		g_clPortC( 0x00 );
-DebounceClass		g_clPortD( 0x00 );
-DebounceClass		g_clPortE( 0x00 );
-DebounceClass		g_clPortF( 0x00 );
-
-volatile uint8_t	g_usPortBInputs;
-volatile uint8_t	g_usPortBOutputs;
-volatile uint8_t	g_usPortCInputs;
-volatile uint8_t	g_usPortCOutputs;
-volatile uint8_t	g_usPortDInputs;
-volatile uint8_t	g_usPortDOutputs;
-volatile uint8_t	g_usPortEInputs;
-volatile uint8_t	g_usPortEOutputs;
-volatile uint8_t	g_usPortFInputs;
-volatile uint8_t	g_usPortFOutputs;
-
-uint32_t			g_ulMillisFlash	= 0L;
-
-typedef uint8_t (*func_ptr_t)( uint8_t );
+//----------------------------------------------------------------------
+//	one debouncer for all universal pins (bit n = IO pin n)
+//
+DebounceClass< uint16_t >	g_clDebounce( 0x0000 );
 
 //----------------------------------------------------------------------
-//	this array contains the mapping	universal pin numbering to
-//	pin of port
+//	input and output mask of each port, index is the port ID
 //
-uint8_t	g_arPortPins[ IO_NUMBERS ] =
-{
-	PB6, PB5, PB7, PB7, PB4, PB2, PB7, PB6, PB6, PB5, PB7, PB6, PB5, PB4, PB1, PB0
-};
+uint8_t				g_arusPortInputs[  PORT_ID_COUNT ];
+uint8_t				g_arusPortOutputs[ PORT_ID_COUNT ];
+
+uint32_t			g_ulMillisFlash	= 0L;
 
 //----------------------------------------------------------------------
 //	this array contains the mapping universal pin numbering to
-//	address of variable containing the input mask of a port
-//
-volatile uint8_t * g_arInputMasks[ IO_NUMBERS ] =
-{
-	&g_usPortDInputs,
-	&g_usPortDInputs,
-	&g_usPortDInputs,
-	&g_usPortBInputs,
-	&g_usPortBInputs,
-	&g_usPortEInputs,
-	&g_usPortCInputs,
-	&g_usPortCInputs,
-	&g_usPortBInputs,
-	&g_usPortBInputs,
-	&g_usPortFInputs,
-	&g_usPortFInputs,
-	&g_usPortFInputs,
-	&g_usPortFInputs,
-	&g_usPortFInputs,
-	&g_usPortFInputs
+//	pin code (port and pin of port), see board_pinout.h
+//
+const uint8_t	g_arPinCodes[ IO_NUMBERS ] PROGMEM =
+{
+	Board::PinCode(  0 ), Board::PinCode(  1 ), Board::PinCode(  2 ), Board::PinCode(  3 ),
+	Board::PinCode(  4 ), Board::PinCode(  5 ), Board::PinCode(  6 ), Board::PinCode(  7 ),
+	Board::PinCode(  8 ), Board::PinCode(  9 ), Board::PinCode( 10 ), Board::PinCode( 11 ),
+	Board::PinCode( 12 ), Board::PinCode( 13 ), Board::PinCode( 14 ), Board::PinCode( 15 )
 };
 
 //----------------------------------------------------------------------
-//	this array contains the mapping universal pin numbering to
-//	address of variable containing the output mask of a port
-//
-volatile uint8_t * g_arOutputMasks[ IO_NUMBERS ] =
-{
-	&g_usPortDOutputs,
-	&g_usPortDOutputs,
-	&g_usPortDOutputs,
-	&g_usPortBOutputs,
-	&g_usPortBOutputs,
-	&g_usPortEOutputs,
-	&g_usPortCOutputs,
-	&g_usPortCOutputs,
-	&g_usPortBOutputs,
-	&g_usPortBOutputs,
-	&g_usPortFOutputs,
-	&g_usPortFOutputs,
-	&g_usPortFOutputs,
-	&g_usPortFOutputs,
-	&g_usPortFOutputs,
-	&g_usPortFOutputs
+//	this array contains the mask of the pin of port for each pin
+//	of port, so no variable shift is needed at runtime
+//
+const uint8_t	g_arPinMasks[ 8 ] PROGMEM =
+{
+	0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80
 };
 
 //----------------------------------------------------------------------
-//	this array contains the mapping universal pin numbering to
-//	address of function for reading the inputs of a port
-//
-func_ptr_t	g_arFunctions[ IO_NUMBERS ] =
-{
-	GetKeyStatePortD,
-	GetKeyStatePortD,
-	GetKeyStatePortD,
-	GetKeyStatePortB,
-	GetKeyStatePortB,
-	GetKeyStatePortE,
-	GetKeyStatePortC,
-	GetKeyStatePortC,
-	GetKeyStatePortB,
-	GetKeyStatePortB,
-	GetKeyStatePortF,
-	GetKeyStatePortF,
-	GetKeyStatePortF,
-	GetKeyStatePortF,
-	GetKeyStatePortF,
-	GetKeyStatePortF
+//	this array maps the state of a port to the universal pin bits,
+//	one table for the low nibble and one for the high nibble
+//	of each port:
+//		g_aruiPortToIO[ port ID ][ 0 ][ low  nibble ]
+//		g_aruiPortToIO[ port ID ][ 1 ][ high nibble ]
+//
+#define NIBBLE_TO_IO( port, shift )												\
+	PortToIOBits( port, 0x00 << shift ), PortToIOBits( port, 0x01 << shift ),	\
+	PortToIOBits( port, 0x02 << shift ), PortToIOBits( port, 0x03 << shift ),	\
+	PortToIOBits( port, 0x04 << shift ), PortToIOBits( port, 0x05 << shift ),	\
+	PortToIOBits( port, 0x06 << shift ), PortToIOBits( port, 0x07 << shift ),	\
+	PortToIOBits( port, 0x08 << shift ), PortToIOBits( port, 0x09 << shift ),	\
+	PortToIOBits( port, 0x0A << shift ), PortToIOBits( port, 0x0B << shift ),	\
+	PortToIOBits( port, 0x0C << shift ), PortToIOBits( port, 0x0D << shift ),	\
+	PortToIOBits( port, 0x0E << shift ), PortToIOBits( port, 0x0F << shift )
+
+#define PORT_TO_IO( port )	{ { NIBBLE_TO_IO( port, 0 ) }, { NIBBLE_TO_IO( port, 4 ) } }
+
+const uint16_t	g_aruiPortToIO[ PORT_ID_COUNT ][ 2 ][ 16 ] PROGMEM =
+{
+	PORT_TO_IO( PORT_ID_B ),
+	PORT_TO_IO( PORT_ID_C ),
+	PORT_TO_IO( PORT_ID_D ),
+	PORT_TO_IO( PORT_ID_E ),
+	PORT_TO_IO( PORT_ID_F )
 };
 
 //----------------------------------------------------------------------
-//	this array contains the mapping universal pin numbering to
-//	address of port to set an output
-//
-volatile uint8_t * g_arPorts[ IO_NUMBERS ] =
-{
-	&PORTD,
-	&PORTD,
-	&PORTD,
-	&PORTB,
-	&PORTB,
-	&PORTE,
-	&PORTC,
-	&PORTC,
-	&PORTB,
-	&PORTB,
-	&PORTF,
-	&PORTF,
-	&PORTF,
-	&PORTF,
-	&PORTF,
-	&PORTF
+//	this array maps universal pin bits to the bits of a port,
+//	one table for each nibble of the universal pin word:
+//		g_arusIOToPort[ port ID ][ n ][ nibble n ]
+//
+#define IO_TO_NIBBLE( port, shift )												\
+	IOToPortBits( port, 0x0 << shift ), IOToPortBits( port, 0x1 << shift ),	\
+	IOToPortBits( port, 0x2 << shift ), IOToPortBits( port, 0x3 << shift ),	\
+	IOToPortBits( port, 0x4 << shift ), IOToPortBits( port, 0x5 << shift ),	\
+	IOToPortBits( port, 0x6 << shift ), IOToPortBits( port, 0x7 << shift ),	\
+	IOToPortBits( port, 0x8 << shift ), IOToPortBits( port, 0x9 << shift ),	\
+	IOToPortBits( port, 0xA << shift ), IOToPortBits( port, 0xB << shift ),	\
+	IOToPortBits( port, 0xC << shift ), IOToPortBits( port, 0xD << shift ),	\
+	IOToPortBits( port, 0xE << shift ), IOToPortBits( port, 0xF << shift )
+
+#define IO_TO_PORT( port )	{	{ IO_TO_NIBBLE( port,  0 ) }, { IO_TO_NIBBLE( port,  4 ) },	\
+								{ IO_TO_NIBBLE( port,  8 ) }, { IO_TO_NIBBLE( port, 12 ) }	}
+
+const uint8_t	g_arusIOToPort[ PORT_ID_COUNT ][ 4 ][ 16 ] PROGMEM =
+{
+	IO_TO_PORT( PORT_ID_B ),
+	IO_TO_PORT( PORT_ID_C ),
+	IO_TO_PORT( PORT_ID_D ),
+	IO_TO_PORT( PORT_ID_E ),
+	IO_TO_PORT( PORT_ID_F )
 };
 
 
 //==========================================================================
 //
-//		F U N C T I O N S
+//		L O C A L   F U N C T I O N S
 //
 //==========================================================================
 
+//**********************************************************************
+//	PortToIO
 //----------------------------------------------------------------------
-//	the functions just serve as mapping functions to
-//	the class functions for each port
+//	maps the value of the port with the ID 'usPortId' to the
+//	universal pin bits
 //
-uint8_t GetKeyStatePortB( uint8_t usMask )
+static inline uint16_t PortToIO( uint8_t usPortId, uint8_t usValue )
 {
-	return( g_clPortB.GetKeyState( usMask ) );
+	return(		pgm_read_word( &g_aruiPortToIO[ usPortId ][ 0 ][ usValue & 0x0F ] )
+			|	pgm_read_word( &g_aruiPortToIO[ usPortId ][ 1 ][ usValue >> 4   ] ) );
 }
 
-uint8_t GetKeyStatePortC( uint8_t usMask )
-{
-	return( g_clPortC.GetKeyState( usMask ) );
-}
 
-uint8_t GetKeyStatePortD( uint8_t usMask )
+//**********************************************************************
+//	IOToPort
+//----------------------------------------------------------------------
+//	the other way round: maps the universal pin bits to the bits
+//	of the port with the ID 'usPortId'
+//
+static inline uint8_t IOToPort( uint8_t usPortId, uint16_t uiValue )
 {
-	return( g_clPortD.GetKeyState( usMask ) );
+	return(		pgm_read_byte( &g_arusIOToPort[ usPortId ][ 0 ][  uiValue        & 0x0F ] )
+			|	pgm_read_byte( &g_arusIOToPort[ usPortId ][ 1 ][ (uiValue >>  4) & 0x0F ] )
+			|	pgm_read_byte( &g_arusIOToPort[ usPortId ][ 2 ][ (uiValue >>  8) & 0x0F ] )
+			|	pgm_read_byte( &g_arusIOToPort[ usPortId ][ 3 ][  uiValue >> 12         ] ) );
 }
 
-uint8_t GetKeyStatePortE( uint8_t usMask )
+
+//==========================================================================
+//
+//		I N T E R R U P T S
+//
+//==========================================================================
+
+//**********************************************************************
+//	Timer 0 compare B
+//----------------------------------------------------------------------
+//	Timer 0 overflows every 1.024 ms (millis()), the compare B
+//	interrupt occurs once in each period.
+//
+ISR( TIMER0_COMPB_vect )
 {
-	return( g_clPortE.GetKeyState( usMask ) );
+	g_clControl.SampleTick();
 }
 
-uint8_t GetKeyStatePortF( uint8_t usMask )
+
+#ifdef INPUT_EDGE_CAPTURE
+//**********************************************************************
+//	Pin change 0 (PB0 .. PB7)
+//----------------------------------------------------------------------
+//	only the inputs of port B are enabled in PCMSK0
+//
+ISR( PCINT0_vect )
 {
-	return( g_clPortF.GetKeyState( usMask ) );
+	g_clControl.EdgeCapture();
 }
+#endif
 
 
 //==========================================================================
@@ -383,16 +380,40 @@ uint8_t GetKeyStatePortF( uint8_t usMask )
 //------------------------------------------------------------------
 IO_ControlClass::IO_ControlClass()
 {
-	g_usPortBInputs		= 0;
-	g_usPortBOutputs	= 0;
-	g_usPortCInputs		= 0;
-	g_usPortCOutputs	= 0;
-	g_usPortDInputs		= 0;
-	g_usPortDOutputs	= 0;
-	g_usPortEInputs		= 0;
-	g_usPortEOutputs	= 0;
-	g_usPortFInputs		= 0;
-	g_usPortFOutputs	= 0;
+	m_uiOutputs			= 0x0000;
+	m_bLedGreen			= false;
+	m_bLedRed			= false;
+	m_uiInputs			= 0x0000;
+	m_usSequence		= 0;
+	m_usChanges			= 0;
+	m_ulChangeTime		= 0L;
+	m_usSampleCounter	= 0;
+	m_usChangesSeen		= 0;
+
+#ifdef BENCHMARK_HOT_PATH
+	m_bDryRun			= false;
+	m_usDryRunPort		= 0;
+#endif
+
+#ifdef INPUT_EDGE_CAPTURE
+	m_usEdgeHead		= 0;
+	m_usEdgeTail		= 0;
+	m_usEdgeLost		= 0;
+	m_usEdgePins		= 0;
+	m_usEdgePending		= 0;
+
+	for( uint8_t idx = 0 ; idx < 8 ; idx++ )
+	{
+		m_arulEdgeTime[ idx ] = 0L;
+		m_arusEdgeLast[ idx ] = 0;
+	}
+#endif
+
+	for( uint8_t idx = 0 ; idx < PORT_ID_COUNT ; idx++ )
+	{
+		g_arusPortInputs[  idx ] = 0;
+		g_arusPortOutputs[ idx ] = 0;
+	}
 }
 
 
@@ -404,167 +425,504 @@ IO_ControlClass::IO_ControlClass()
 void IO_ControlClass::Init( uint16_t uiOutputs )
 {
 	uint16_t	uiMask = 0x0001;
+	uint8_t		usPinCode;
+	uint8_t		usInputs;
+	uint8_t		usOutputs;
+
+#ifdef FAST_BOOT
+	uint32_t	ulStart;
+	uint16_t	uiLevels;
+	uint16_t	uiNewLevels;
+	uint8_t		usStable	= 1;
+	uint8_t		usSREG;
+#endif
 
 
+	//--------------------------------------------------------------
+	//	no sampling while the ports are configured
+	//
+	TIMSK0 &= ~_BV( OCIE0B );
+
+#ifdef INPUT_EDGE_CAPTURE
+	PCICR &= ~_BV( PCIE0 );
+#endif
+
 	m_uiOutputs = uiOutputs;
 
+	for( uint8_t idx = 0 ; idx < PORT_ID_COUNT ; idx++ )
+	{
+		g_arusPortInputs[  idx ] = 0;
+		g_arusPortOutputs[ idx ] = 0;
+	}
+
 	//--------------------------------------------------------------
 	//	identify the input and output mask for each port
 	//
-	//	the trick here is that the addresses of the variables
-	//	holding the mask are stored in an array just as the
-	//	port pins. The mapping of universal pin numbering to ports
-	//	is done by storing the right variable address into
-	//	the right array place and storing the right pin number
-	//	into the right arry place
-	//	So the only thing to do here is to find out if a universal
-	//	pin is configured as output or as input
+	//	the pin code of each universal pin holds the port ID
+	//	and the pin of the port. So the only thing to do here
+	//	is to find out if a universal pin is configured as
+	//	output or as input
 	//
 	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
 	{
+		usPinCode = pgm_read_byte( &g_arPinCodes[ idx ] );
+
 		if( uiOutputs & uiMask )
 		{
-			*g_arOutputMasks[ idx ] |= _BV( g_arPortPins[ idx ] );
+			g_arusPortOutputs[ PIN_CODE_PORT( usPinCode ) ] |= PIN_CODE_MASK( usPinCode );
 		}
 		else
 		{
-			*g_arInputMasks[ idx ] |= _BV( g_arPortPins[ idx ] );
+			g_arusPortInputs[ PIN_CODE_PORT( usPinCode ) ] |= PIN_CODE_MASK( usPinCode );
 		}
 
 		uiMask <<= 1;
 	}
 
-	//----	Port B  ------------------------------------------------
+	//--------------------------------------------------------------
+	//	LEDs and relais are outputs too
 	//
-	if( g_usPortBInputs )
+	g_arusPortOutputs[ PIN_CODE_PORT( Board::LedGreen ) ]	|= PIN_CODE_MASK( Board::LedGreen );
+	g_arusPortOutputs[ PIN_CODE_PORT( Board::LedRed ) ]		|= PIN_CODE_MASK( Board::LedRed );
+
+	if( PIN_CODE_NONE != Board::Relais )
 	{
-		DDRB	&= ~g_usPortBInputs;	//	configure as Input
-		PORTB	|=  g_usPortBInputs;	//	Pull-Up on
+		g_arusPortOutputs[ PIN_CODE_PORT( Board::Relais ) ]	|= PIN_CODE_MASK( Board::Relais );
 	}
 
-#if PLATINE_VERSION == 1
+	//----	configure the ports  ----------------------------------
+	//
+	for( uint8_t idx = 0 ; idx < PORT_ID_COUNT ; idx++ )
+	{
+		usInputs	= g_arusPortInputs[  idx ];
+		usOutputs	= g_arusPortOutputs[ idx ];
 
-	DDRB	|=  (g_usPortBOutputs | LED_GREEN | LED_RED);	//	configure as Output
-	PORTB	&= ~(g_usPortBOutputs | LED_GREEN | LED_RED);	//	switch off
+		if( usInputs )
+		{
+			DdrRegister(  idx )	&= ~usInputs;	//	configure as Input
+			PortRegister( idx )	|=  usInputs;	//	Pull-Up on
+		}
 
-#else
+		if( usOutputs )
+		{
+			DdrRegister(  idx )	|=  usOutputs;	//	configure as Output
+			PortRegister( idx )	&= ~usOutputs;	//	switch off
+		}
+	}
 
-	DDRB	|=  (g_usPortBOutputs | LED_GREEN | LED_RED | RELAIS);	//	configure as Output
-	PORTB	&= ~(g_usPortBOutputs | LED_GREEN | LED_RED | RELAIS);	//	switch off
+	//----	Start sampling  ----------------------------------------
+	//	Timer 0 is running with 1 kHz for millis(),
+	//	the compare B interrupt is free to use.
+	//
+	m_usSampleCounter	= 0;
+	m_ulChangeTime		= millis();
+	OCR0B				= 0x80;
+	TIMSK0			   |= _BV( OCIE0B );
+
+#ifdef INPUT_EDGE_CAPTURE
+	//----	Start edge capture  ------------------------------------
+	//	PB0 .. PB7 are PCINT0 .. PCINT7, so the input mask of
+	//	port B is the pin change mask
+	//
+	m_usEdgeHead	= 0;
+	m_usEdgeTail	= 0;
+	m_usEdgeLost	= 0;
+	m_usEdgePending	= 0;
+	m_usEdgePins	= PINB;
+
+	for( uint8_t idx = 0 ; idx < 8 ; idx++ )
+	{
+		m_arulEdgeTime[ idx ] = m_ulChangeTime;
+	}
 
+	PCMSK0			= g_arusPortInputs[ PORT_ID_B ];
+	PCIFR			= _BV( PCIF0 );
+	PCICR		   |= _BV( PCIE0 );
 #endif
 
-	//----	Port C  ------------------------------------------------
+	//----	Read actual Inputs  ------------------------------------
 	//
-	if( g_usPortCInputs )
+#ifdef FAST_BOOT
+	uiLevels	= ReadLevels();
+	ulStart		= millis();
+
+	while(		(BOOT_STABLE_READS > usStable)
+			&&	((millis() - ulStart) < BOOT_SETTLE_MAX)	)
 	{
-		DDRC	&= ~g_usPortCInputs;	//	configure as Input
-		PORTC	|=  g_usPortCInputs;	//	Pull-Up on
+		delay( 1 );
+
+		uiNewLevels = ReadLevels();
+
+		if( uiNewLevels == uiLevels )
+		{
+			usStable++;
+		}
+		else
+		{
+			uiLevels	= uiNewLevels;
+			usStable	= 1;
+		}
 	}
 
-	if( g_usPortCOutputs )
+	if( BOOT_STABLE_READS <= usStable )
 	{
-		DDRC	|=  g_usPortCOutputs;	//	configure as Output
-		PORTC	&= ~g_usPortCOutputs;	//	switch off
+		usSREG = SREG;
+		cli();
+
+		g_clDebounce.Confirm( ~uiOutputs, uiLevels );
+		PublishInputs();
+
+		SREG = usSREG;
 	}
+#else
+	delay( (INIT_READ_INPUT_COUNT * INPUT_SAMPLE_TIME) + 20 );
+#endif
+}
 
-	//----	Port D  ------------------------------------------------
-	//
-	if( g_usPortDInputs )
+
+//******************************************************************
+//	Reconfigure
+//------------------------------------------------------------------
+//	takes over a new configuration while running.
+//	Only the pins that change from output to input or vice versa
+//	are configured again:
+//		-	a new output is switched off
+//		-	a new input gets the pull-up, its level is taken over
+//			as debounced state at once
+//	All other pins are not touched.
+//
+void IO_ControlClass::Reconfigure( uint16_t uiOutputs )
+{
+	uint16_t	uiNewInputs		= m_uiOutputs & ~uiOutputs;
+	uint16_t	uiNewOutputs	= uiOutputs & ~m_uiOutputs;
+	uint8_t		usInputs;
+	uint8_t		usOutputs;
+	uint8_t		usSREG;
+
+	if( 0 == (uiNewInputs | uiNewOutputs) )
 	{
-		DDRD	&= ~g_usPortDInputs;	//	configure as Input
-		PORTD	|=  g_usPortDInputs;	//	Pull-Up on
+		return;
 	}
 
-	if( g_usPortDOutputs )
+	usSREG = SREG;
+	cli();
+
+	for( uint8_t idx = 0 ; idx < PORT_ID_COUNT ; idx++ )
 	{
-		DDRD	|=  g_usPortDOutputs;	//	configure as Output
-		PORTD	&= ~g_usPortDOutputs;	//	switch off
+		usInputs	= IOToPort( idx, uiNewInputs );
+		usOutputs	= IOToPort( idx, uiNewOutputs );
+
+		if( usOutputs )
+		{
+			PortRegister( idx )	&= ~usOutputs;	//	switch off
+			DdrRegister(  idx )	|=  usOutputs;	//	configure as Output
+		}
+
+		if( usInputs )
+		{
+			DdrRegister(  idx )	&= ~usInputs;	//	configure as Input
+			PortRegister( idx )	|=  usInputs;	//	Pull-Up on
+		}
+
+		g_arusPortInputs[  idx ] = (g_arusPortInputs[  idx ] & ~usOutputs) | usInputs;
+		g_arusPortOutputs[ idx ] = (g_arusPortOutputs[ idx ] & ~usInputs)  | usOutputs;
 	}
 
-	//----	Port E  ------------------------------------------------
+	m_uiOutputs = uiOutputs;
+
+#ifdef INPUT_EDGE_CAPTURE
+	PCMSK0			 = g_arusPortInputs[ PORT_ID_B ];
+	m_usEdgePending	&= PCMSK0;
+#endif
+
+	SREG = usSREG;
+
+	//----	give the pull-ups some time  ---------------------------
 	//
-	if( g_usPortEInputs )
+	delayMicroseconds( 10 );
+
+	cli();
+
+	g_clDebounce.Confirm( uiNewInputs, ReadLevels() );
+
+#ifdef INPUT_EDGE_CAPTURE
+	m_usEdgePins = PINB;
+#endif
+
+	PublishInputs();
+
+	SREG = usSREG;
+}
+
+
+//******************************************************************
+//	SetSamples
+//------------------------------------------------------------------
+//	sets the number of samples needed for a falling edge (pin goes
+//	low, input ON) and a rising edge (pin goes high, input OFF)
+//	'0' selects the default DEBOUNCE_DEFAULT_SAMPLES
+//
+void IO_ControlClass::SetSamples( uint8_t usIOPin, uint8_t usFall, uint8_t usRise )
+{
+	uint8_t	usSREG;
+
+	if( IO_NUMBERS > usIOPin )
 	{
-		DDRE	&= ~g_usPortEInputs;	//	configure as Input
-		PORTE	|=  g_usPortEInputs;	//	Pull-Up on
+		usSREG = SREG;
+		cli();
+
+		//----------------------------------------------------------
+		//	a low pin is a pressed key
+		//
+		g_clDebounce.SetSamples( ((uint16_t)1) << usIOPin, usFall, usRise );
+
+		SREG = usSREG;
 	}
+}
 
-	if( g_usPortEOutputs )
+
+//******************************************************************
+//	SampleTick
+//------------------------------------------------------------------
+//	This function is called by the timer interrupt every ms.
+//	Every INPUT_SAMPLE_TIME ms the inputs will be sampled.
+//	Captured edges are checked every ms.
+//
+void IO_ControlClass::SampleTick( void )
+{
+#ifdef INPUT_EDGE_CAPTURE
+	CheckEdges();
+#endif
+
+	if( ++m_usSampleCounter >= INPUT_SAMPLE_TIME )
 	{
-		DDRE	|=  g_usPortEOutputs;	//	configure as Output
-		PORTE	&= ~g_usPortEOutputs;	//	switch off
+		m_usSampleCounter = 0;
+
+		SampleInputs();
 	}
+}
 
-	//----	Port F  ------------------------------------------------
-	//
-	if( g_usPortFInputs )
+
+//******************************************************************
+//	SampleInputs
+//------------------------------------------------------------------
+//	gathers the levels of all universal pins, debounces them in
+//	one pass and publishes the state of the inputs.
+//	The state of each port is read once.
+//
+//	ATTENTION: only to be called by the interrupt
+//	(or with interrupts disabled)
+//
+void IO_ControlClass::SampleInputs( void )
+{
+	g_clDebounce.Work( ReadLevels() );
+
+	PublishInputs();
+}
+
+
+//******************************************************************
+//	ReadLevels
+//------------------------------------------------------------------
+//	returns the levels of all universal pins (bit n = IO pin n),
+//	only the ports with inputs are read, each one once
+//
+uint16_t IO_ControlClass::ReadLevels( void )
+{
+	uint16_t	uiLevels = 0x0000;
+
+	for( uint8_t idx = 0 ; idx < PORT_ID_COUNT ; idx++ )
 	{
-		DDRF	&= ~g_usPortFInputs;	//	configure as Input
-		PORTF	|=  g_usPortFInputs;	//	Pull-Up on
+		if( g_arusPortInputs[ idx ] )
+		{
+			uiLevels |= PortToIO( idx, PinRegister( idx ) );
+		}
 	}
 
-	if( g_usPortFOutputs )
+	return( uiLevels );
+}
+
+
+//******************************************************************
+//	PublishInputs
+//------------------------------------------------------------------
+//	publishes the debounced state of the inputs in universal pin
+//	numbering (bit n = IO pin n)
+//
+//	ATTENTION: only to be called by the interrupt
+//	(or with interrupts disabled)
+//
+void IO_ControlClass::PublishInputs( void )
+{
+	uint16_t	uiState	= g_clDebounce.GetKeyState( ~m_uiOutputs );
+
+	if( uiState != m_uiInputs )
 	{
-		DDRF	|=  g_usPortFOutputs;	//	configure as Output
-		PORTF	&= ~g_usPortFOutputs;	//	switch off
+		m_ulChangeTime = millis();
+		m_usChanges++;
 	}
 
-	//----	Read actual Inputs  ------------------------------------
-	//
-	for( uint8_t idx = 0 ; idx < INIT_READ_INPUT_COUNT ; idx++ )
+	m_uiInputs = uiState;
+	m_usSequence++;
+}
+
+
+#ifdef INPUT_EDGE_CAPTURE
+//******************************************************************
+//	EdgeCapture
+//------------------------------------------------------------------
+//	This function is called by the pin change interrupt.
+//	The changed pins of port B are stored with the time in the
+//	edge ring. If the ring is full the edge is lost, this will
+//	be handled by 'CheckEdges()'.
+//
+void IO_ControlClass::EdgeCapture( void )
+{
+	uint8_t	usPins		= PINB;
+	uint8_t	usChanged	= (usPins ^ m_usEdgePins) & PCMSK0;
+	uint8_t	usNext;
+
+	m_usEdgePins = usPins;
+
+	if( 0 == usChanged )
 	{
-		delay( 20 );
+		return;
+	}
+
+	usNext = (m_usEdgeHead + 1) & (EDGE_RING_SIZE - 1);
 
-		ReadInputs();
+	if( usNext == m_usEdgeTail )
+	{
+		m_usEdgeLost |= usChanged;
+		return;
 	}
 
-	delay( 20 );
+	m_arEdgeRing[ m_usEdgeHead ].ulTime		= millis();
+	m_arEdgeRing[ m_usEdgeHead ].usPins		= usPins;
+	m_arEdgeRing[ m_usEdgeHead ].usChanged	= usChanged;
+
+	m_usEdgeHead = usNext;
 }
 
 
 //******************************************************************
-//	ReadInputs
+//	CheckEdges
 //------------------------------------------------------------------
-//	This function should be called at regular intervals,
-//	for example: every 20 ms
+//	This function is called by the timer interrupt every ms.
+//	It takes the edges out of the ring and remembers for each pin
+//	the time of the first edge and the time of the last edge.
+//	If no edge was seen on a pin for EDGE_SETTLE_TIME ms, the
+//	level of the pin is stable and will be taken over by the
+//	debouncer at once.
+//
+//	ATTENTION: only to be called by the interrupt
 //
-void IO_ControlClass::ReadInputs( void )
+void IO_ControlClass::CheckEdges( void )
 {
-	//----------------------------------------------------------
-	//	handle the inputs for each port
-	//
-	if( g_usPortBInputs )
+	uint32_t	ulNow;
+	uint8_t		usChanged;
+	uint8_t		usStable	= 0;
+	uint8_t		usMask;
+
+	if( (m_usEdgeTail == m_usEdgeHead) && !m_usEdgePending && !m_usEdgeLost )
 	{
-		g_clPortB.Work( PINB );
+		return;
 	}
 
-	if( g_usPortCInputs )
+	ulNow = millis();
+
+	while( m_usEdgeTail != m_usEdgeHead )
 	{
-		g_clPortC.Work( PINC );
+		edge_entry_t	*pEdge = &m_arEdgeRing[ m_usEdgeTail ];
+
+		usChanged	= pEdge->usChanged;
+		usMask		= 0x01;
+
+		for( uint8_t idx = 0 ; idx < 8 ; idx++ )
+		{
+			if( usChanged & usMask )
+			{
+				if( !(m_usEdgePending & usMask) )
+				{
+					m_arulEdgeTime[ idx ] = pEdge->ulTime;
+				}
+
+				m_arusEdgeLast[ idx ] = (uint8_t)pEdge->ulTime;
+			}
+
+			usMask <<= 1;
+		}
+
+		m_usEdgePending	|= usChanged;
+		m_usEdgeTail	 = (m_usEdgeTail + 1) & (EDGE_RING_SIZE - 1);
 	}
 
-	if( g_usPortDInputs )
+	//--------------------------------------------------------------
+	//	lost edges are handled as edges right now
+	//
+	if( m_usEdgeLost )
 	{
-		g_clPortD.Work( PIND );
+		usChanged		= m_usEdgeLost;
+		m_usEdgeLost	= 0;
+		usMask			= 0x01;
+
+		for( uint8_t idx = 0 ; idx < 8 ; idx++ )
+		{
+			if( usChanged & usMask )
+			{
+				if( !(m_usEdgePending & usMask) )
+				{
+					m_arulEdgeTime[ idx ] = ulNow;
+				}
+
+				m_arusEdgeLast[ idx ] = (uint8_t)ulNow;
+			}
+
+			usMask <<= 1;
+		}
+
+		m_usEdgePending |= usChanged;
 	}
 
-	if( g_usPortEInputs )
+	//--------------------------------------------------------------
+	//	find the pins without an edge for EDGE_SETTLE_TIME ms
+	//
+	usMask = 0x01;
+
+	for( uint8_t idx = 0 ; idx < 8 ; idx++ )
 	{
-		g_clPortE.Work( PINE );
+		if(		(m_usEdgePending & usMask)
+			&&	(EDGE_SETTLE_TIME <= (uint8_t)((uint8_t)ulNow - m_arusEdgeLast[ idx ])) )
+		{
+			usStable |= usMask;
+		}
+
+		usMask <<= 1;
 	}
 
-	if( g_usPortFInputs )
+	if( usStable )
 	{
-		g_clPortF.Work( PINF );
+		m_usEdgePending &= ~usStable;
+
+		g_clDebounce.Confirm( PortToIO( PORT_ID_B, usStable ), PortToIO( PORT_ID_B, PINB ) );
+
+		PublishInputs();
 	}
+}
+#endif
 
-	//----------------------------------------------------------
-	//	let the LED(s) flash
-	//
+
+//******************************************************************
+//	CheckLeds
+//------------------------------------------------------------------
+//	lets the LED(s) flash
+//	This function should be called in each loop.
+//
+void IO_ControlClass::CheckLeds( void )
+{
 	if( m_bLedGreen || m_bLedRed )
 	{
-		if( millis() > g_ulMillisFlash )
+		if( IsTimeOver( millis(), g_ulMillisFlash ) )
 		{
 			g_ulMillisFlash = millis() + FLASH_TIME;
 
@@ -573,12 +931,12 @@ void IO_ControlClass::ReadInputs( void )
 				if( IsGreenLedOn() )
 				{
 					//----	switch LED off  ----
-					cbi( PORTB, LED_GREEN );
+					PinLow( Board::LedGreen );
 				}
 				else
 				{
 					//----	switch LED on  ----
-					sbi( PORTB, LED_GREEN );
+					PinHigh( Board::LedGreen );
 				}
 			}
 
@@ -587,12 +945,12 @@ void IO_ControlClass::ReadInputs( void )
 				if( IsRedLedOn() )
 				{
 					//----	switch LED off  ----
-					cbi( PORTB, LED_RED );
+					PinLow( Board::LedRed );
 				}
 				else
 				{
 					//----	switch LED on  ----
-					sbi( PORTB, LED_RED );
+					PinHigh( Board::LedRed );
 				}
 			}
 		}
@@ -606,16 +964,93 @@ void IO_ControlClass::ReadInputs( void )
 //
 bool IO_ControlClass::IsInputSet( uint8_t usIOPin )
 {
-	uint8_t	usMask	= 0x01;
-	bool	retval	= false;
+	return( 0 != (GetInputs() & (((uint16_t)1) << usIOPin)) );
+}
 
-	if( IO_NUMBERS > usIOPin )
+
+//******************************************************************
+//	GetInputs
+//------------------------------------------------------------------
+//	returns the debounced state of all inputs in universal pin
+//	numbering (bit n = IO pin n)
+//	The state is written by the interrupt. If the interrupt
+//	occurs while reading, the sequence number changes and the
+//	state will be read again. So no need to block the interrupts.
+//
+uint16_t IO_ControlClass::GetInputs( void )
+{
+	uint16_t	uiState;
+	uint8_t		usSequence;
+
+	do
 	{
-		usMask <<=  g_arPortPins[ usIOPin ];
-		retval	 = (0 != (*g_arFunctions[ usIOPin ])( usMask ));
+		usSequence	= m_usSequence;
+		uiState		= m_uiInputs;
+
+	}	while( usSequence != m_usSequence );
+
+	return( uiState );
+}
+
+
+//******************************************************************
+//	GetChangedInputs
+//------------------------------------------------------------------
+//	returns true if the state of the inputs has changed since the
+//	last call. In that case the state is stored in 'puiInputs'.
+//
+bool IO_ControlClass::GetChangedInputs( uint16_t *puiInputs )
+{
+	uint8_t	usChanges = m_usChanges;
+
+	if( usChanges == m_usChangesSeen )
+	{
+		return( false );
+	}
+
+	m_usChangesSeen	= usChanges;
+	*puiInputs		= GetInputs();
+
+	return( true );
+}
+
+
+//******************************************************************
+//	GetChangeTime
+//------------------------------------------------------------------
+//	returns the time (millis()) at which the input has changed:
+//		-	with edge capture the time of the first edge of the pin
+//		-	else the time the last change was published
+//
+uint32_t IO_ControlClass::GetChangeTime( uint8_t usIOPin )
+{
+	uint32_t	ulTime;
+	uint8_t		usSREG;
+
+#ifdef INPUT_EDGE_CAPTURE
+	uint8_t		usPinCode	= pgm_read_byte( &g_arPinCodes[ usIOPin ] );
+#else
+	(void)usIOPin;
+#endif
+
+	usSREG = SREG;
+	cli();
+
+#ifdef INPUT_EDGE_CAPTURE
+	if(		(PORT_ID_B == PIN_CODE_PORT( usPinCode ))
+		&&	(PCMSK0 & PIN_CODE_MASK( usPinCode ))	)
+	{
+		ulTime = m_arulEdgeTime[ PIN_CODE_BIT( usPinCode ) ];
+	}
+	else
+#endif
+	{
+		ulTime = m_ulChangeTime;
 	}
 
-	return( retval );
+	SREG = usSREG;
+
+	return( ulTime );
 }
 
 
@@ -625,13 +1060,63 @@ bool IO_ControlClass::IsInputSet( uint8_t usIOPin )
 //
 void IO_ControlClass::SetOutput( uint8_t usIOPin, bool bOn )
 {
+	uint8_t	usPinCode	= pgm_read_byte( &g_arPinCodes[ usIOPin ] );
+	uint8_t	usMask		= pgm_read_byte( &g_arPinMasks[ PIN_CODE_BIT( usPinCode ) ] );
+
 	if( bOn )
 	{
-		sbi( *g_arPorts[ usIOPin ], g_arPortPins[ usIOPin ] );
+		PortRegister( PIN_CODE_PORT( usPinCode ) ) |= usMask;
 	}
 	else
 	{
-		cbi( *g_arPorts[ usIOPin ], g_arPortPins[ usIOPin ] );
+		PortRegister( PIN_CODE_PORT( usPinCode ) ) &= ~usMask;
+	}
+}
+
+
+//******************************************************************
+//	SetOutputs
+//------------------------------------------------------------------
+//	sets all outputs whose bit is set in 'uiMask' to the state
+//	of the same bit in 'uiValue' (universal pin numbering).
+//	Each port is written only once and with blocked interrupts,
+//	so all outputs of one port change at the same time.
+//	In a dry run of the benchmark the same work is done on a
+//	dummy register.
+//
+void IO_ControlClass::SetOutputs( uint16_t uiValue, uint16_t uiMask )
+{
+	volatile uint8_t *	pPort;
+	uint8_t				usPortMask;
+	uint8_t				usPortSet;
+	uint8_t				usSREG;
+
+	uiMask &= m_uiOutputs;
+	uiValue &= uiMask;
+
+	for( uint8_t idx = 0 ; idx < PORT_ID_COUNT ; idx++ )
+	{
+		usPortMask = IOToPort( idx, uiMask );
+
+		if( usPortMask )
+		{
+			usPortSet	= IOToPort( idx, uiValue );
+			pPort		= &PortRegister( idx );
+
+#ifdef BENCHMARK_HOT_PATH
+			if( m_bDryRun )
+			{
+				pPort = &m_usDryRunPort;
+			}
+#endif
+
+			usSREG = SREG;
+			cli();
+
+			*pPort = (*pPort & ~usPortMask) | usPortSet;
+
+			SREG = usSREG;
+		}
 	}
 }
 
@@ -644,7 +1129,7 @@ void IO_ControlClass::GreenLedOn( void )
 {
 	m_bLedGreen = false;
 
-	sbi( PORTB, LED_GREEN );
+	PinHigh( Board::LedGreen );
 }
 
 
@@ -656,7 +1141,7 @@ void IO_ControlClass::GreenLedOff( void )
 {
 	m_bLedGreen = false;
 
-	cbi( PORTB, LED_GREEN );
+	PinLow( Board::LedGreen );
 }
 
 
@@ -676,7 +1161,7 @@ void IO_ControlClass::GreenLedFlash( void )
 //
 bool IO_ControlClass::IsGreenLedOn( void )
 {
-	return( bit_is_set( PINB, LED_GREEN ) );
+	return( PinIsHigh( Board::LedGreen ) );
 }
 
 
@@ -688,7 +1173,7 @@ void IO_ControlClass::RedLedOn( void )
 {
 	m_bLedRed = false;
 
-	sbi( PORTB, LED_RED );
+	PinHigh( Board::LedRed );
 }
 
 
@@ -700,7 +1185,7 @@ void IO_ControlClass::RedLedOff( void )
 {
 	m_bLedRed = false;
 
-	cbi( PORTB, LED_RED );
+	PinLow( Board::LedRed );
 }
 
 
@@ -720,5 +1205,5 @@ void IO_ControlClass::RedLedFlash( void )
 //
 bool IO_ControlClass::IsRedLedOn( void )
 {
-	return( bit_is_set( PINB, LED_RED ) );
+	return( PinIsHigh( Board::LedRed ) );
 }
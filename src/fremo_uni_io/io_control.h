@@ -12,6 +12,74 @@
 //#
 //#-------------------------------------------------------------------------
 //#
+//#	File version:	8		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	BENCHMARK_HOT_PATH: dry run, SetOutputs() does not
+//#			write the ports
+//#			new function SetDryRun()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	7		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	FAST_BOOT: Init() waits only until the inputs are stable
+//#			new function ReadLevels()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	6		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new function Reconfigure()
+//#			changes the direction of single pins while running
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	5		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new function SetSamples()
+//#			number of samples for falling and rising edges per pin
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	4		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	optional edge capture by the pin change interrupt
+//#			(compile option INPUT_EDGE_CAPTURE)
+//#			new functions
+//#				EdgeCapture()
+//#				GetChangeTime()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	3		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the inputs are sampled in a timer interrupt
+//#			new functions
+//#				SampleInputs()
+//#				SampleTick()
+//#				GetChangedInputs()
+//#				CheckLeds()
+//#			removed function
+//#				ReadInputs()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new function GetInputs()
+//#			returns the state of all inputs at once
+//#		-	new function SetOutputs()
+//#			sets several outputs at once
+//#
+//#-------------------------------------------------------------------------
+//#
 //#	File version:	1		vom: 14.02.2022
 //#
 //#	Implementation:
@@ -39,6 +107,43 @@
 
 #define IO_NUMBERS			16
 
+//----------------------------------------------------------------------
+//	time between two samples of the inputs in ms (1 .. 255)
+//	the inputs are sampled in the Timer 0 compare B interrupt,
+//	a changed input is stable after four samples (default, see
+//	SetSamples())
+//
+#define INPUT_SAMPLE_TIME	20
+
+#ifdef FAST_BOOT
+//----------------------------------------------------------------------
+//	start up: the levels of the inputs are taken over as soon as
+//	BOOT_STABLE_READS reads (1 ms apart) agree, but the wait is not
+//	longer than BOOT_SETTLE_MAX ms. Inputs still bouncing then are
+//	handled by the debouncer.
+//
+#define BOOT_STABLE_READS	3
+#define BOOT_SETTLE_MAX		(INIT_READ_INPUT_COUNT * INPUT_SAMPLE_TIME)
+#endif
+
+#ifdef INPUT_EDGE_CAPTURE
+//----------------------------------------------------------------------
+//	edge capture (PB4 .. PB7):
+//	an input is stable if no edge was seen for EDGE_SETTLE_TIME ms
+//	(1 .. 255). The ring holds the edges that are not yet handled
+//	by the timer interrupt (size must be a power of 2).
+//
+#define EDGE_SETTLE_TIME	5
+#define EDGE_RING_SIZE		8
+
+typedef struct edge_entry
+{
+	uint32_t	ulTime;
+	uint8_t		usPins;
+	uint8_t		usChanged;
+}	edge_entry_t;
+#endif
+
 
 ////////////////////////////////////////////////////////////////////////
 //	CLASS:	IO_ControlClass
@@ -54,10 +159,26 @@ class IO_ControlClass
 		IO_ControlClass();
 
 		void Init( uint16_t uiOutputs );
-		void ReadInputs( void );
+		void Reconfigure( uint16_t uiOutputs );
+		void SetSamples( uint8_t usIOPin, uint8_t usFall, uint8_t usRise );
+		void SampleInputs( void );
+		void SampleTick( void );
+		void EdgeCapture( void );
+		void CheckLeds( void );
 
 		bool IsInputSet( uint8_t usIOPin );
+		uint16_t GetInputs( void );
+		bool GetChangedInputs( uint16_t *puiInputs );
+		uint32_t GetChangeTime( uint8_t usIOPin );
 		void SetOutput( uint8_t usIOPin, bool bOn );
+		void SetOutputs( uint16_t uiValue, uint16_t uiMask );
+
+#ifdef BENCHMARK_HOT_PATH
+		inline void SetDryRun( bool bDryRun )
+		{
+			m_bDryRun = bDryRun;
+		};
+#endif
 
 		void GreenLedOn(    void );
 		void GreenLedOff(   void );
@@ -73,6 +194,59 @@ class IO_ControlClass
 		uint16_t	m_uiOutputs;
 		bool		m_bLedGreen;
 		bool		m_bLedRed;
+
+#ifdef BENCHMARK_HOT_PATH
+		//----------------------------------------------------------
+		//	m_bDryRun		SetOutputs() writes into m_usDryRunPort
+		//					instead of the port
+		//
+		bool				m_bDryRun;
+		volatile uint8_t	m_usDryRunPort;
+#endif
+
+		//----------------------------------------------------------
+		//	written by the interrupt only:
+		//	m_uiInputs		debounced state of the inputs
+		//	m_usSequence	incremented with each write of m_uiInputs
+		//	m_usChanges		incremented with each change of m_uiInputs
+		//	m_ulChangeTime	time of the last change of m_uiInputs
+		//
+		volatile uint16_t	m_uiInputs;
+		volatile uint8_t	m_usSequence;
+		volatile uint8_t	m_usChanges;
+		volatile uint32_t	m_ulChangeTime;
+		uint8_t				m_usSampleCounter;
+
+#ifdef INPUT_EDGE_CAPTURE
+		//----------------------------------------------------------
+		//	edge capture, index of the arrays is the pin of port B
+		//	m_arEdgeRing	written by the pin change interrupt,
+		//					read by the timer interrupt
+		//	m_usEdgeLost	the ring was full, edges are missing
+		//	m_usEdgePins	PINB at the last pin change interrupt
+		//	m_usEdgePending	pins with an edge that is not yet stable
+		//	m_arulEdgeTime	time of the first edge of the pin
+		//	m_arusEdgeLast	time of the last edge (low byte of ms)
+		//
+		edge_entry_t		m_arEdgeRing[ EDGE_RING_SIZE ];
+		volatile uint8_t	m_usEdgeHead;
+		volatile uint8_t	m_usEdgeTail;
+		volatile uint8_t	m_usEdgeLost;
+		uint8_t				m_usEdgePins;
+		uint8_t				m_usEdgePending;
+		uint32_t			m_arulEdgeTime[ 8 ];
+		uint8_t				m_arusEdgeLast[ 8 ];
+
+		void CheckEdges( void );
+#endif
+
+		void PublishInputs( void );
+		uint16_t ReadLevels( void );
+
+		//----------------------------------------------------------
+		//	value of m_usChanges at the last GetChangedInputs()
+		//
+		uint8_t				m_usChangesSeen;
 };
 
 
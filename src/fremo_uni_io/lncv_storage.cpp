@@ -11,6 +11,130 @@
 //#
 //#-------------------------------------------------------------------------
 //#
+//#	File version:	19		vom: 17.10.2026
+//#
+//#	Bugfix:
+//#		-	the default slot width of the start up broadcast was
+//#			shorter than the burst of one board, the bursts of
+//#			neighbouring boards still overlapped. The slot is now
+//#			at least one burst: IO_NUMBERS * 2 * send delay.
+//#		-	an image of a version before LNCV_CRC_VERSION gets the
+//#			default slot width (LNCV 5) and report window (LNCV 6)
+//#			instead of the '0' the old version left there
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	18		vom: 17.10.2026
+//#
+//#	Bugfix:
+//#		-	a rejected image that already held the default values
+//#			never got a new CRC (no LNCV was changed), so it was
+//#			rejected again at each start
+//#			new function
+//#				WriteCRC()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	17		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add report window (LNCV 6)
+//#			(DEFAULT_REPORT_WINDOW for a new board, '0' for boards
+//#			of older versions: no suppression as before)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	16		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add slot width for the start up broadcast (LNCV 5)
+//#			(DEFAULT_BROADCAST_SLOT for a new board, '0' for boards
+//#			of older versions: no waiting as before)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	15		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	FAST_BOOT: no fixed wait at the end of CheckEEPROM()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	14		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the decoding of the LNCVs was moved from Init() to
+//#			Decode()
+//#			new functions
+//#				Decode()
+//#				Reload()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	13		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	a CRC of all LNCVs is stored behind the LNCVs
+//#			CheckEEPROM() rejects an image with a wrong CRC and
+//#			writes the default values (images of versions before
+//#			LNCV_CRC_VERSION have no CRC, they are taken over)
+//#			WriteLNCV() calculates the new CRC, the interrupt
+//#			writes it after the queued LNCVs
+//#			new function
+//#				CalcCRC()
+//#		-	Init() decodes the LNCVs of each I/O pin into one
+//#			descriptor in one pass without division
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	12		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the EEPROM ready interrupt also writes the journal of the
+//#			output state (see state_journal.h)
+//#			WriteNextByte() returns false if the queue is empty,
+//#			the interrupt is switched off by the ISR
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	11		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	all LNCVs are held in RAM, ReadLNCV() no longer reads
+//#			the EEPROM
+//#		-	WriteLNCV() does not wait for the EEPROM, the LNCV is put
+//#			into a write queue, the EEPROM ready interrupt writes one
+//#			byte after the other
+//#			new functions
+//#				LoadLNCVs()
+//#				WriteNextByte()
+//#				GetPendingWrites()
+//#				Flush()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	10		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add debounce samples for each I/O pin (LNCV 51 .. 66)
+//#			the value is: samples falling edge * 10 + samples rising
+//#			edge (1 .. 7 each, '0' or an invalid value: default)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	9		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add address index for the outputs
+//#			the index is built in function 'Init()' and allows to
+//#			find the outputs for a Loconet address without checking
+//#			all I/O pins
+//#			new functions
+//#				BuildAddressIndex()
+//#				FindOutputAddress()
+//#
+//#-------------------------------------------------------------------------
+//#
 //#	File version:	8		vom: 27.01.2023
 //#
 //#	Bug Fix:
@@ -102,10 +226,14 @@
 //==========================================================================
 
 #include <Arduino.h>
+#include <avr/eeprom.h>
+#include <avr/interrupt.h>
+#include <util/crc16.h>
 
 #include "compile_options.h"
 
 #include "lncv_storage.h"
+#include "state_journal.h"
 
 #ifdef DEBUGGING_PRINTOUT
 #include "debugging.h"
@@ -132,6 +260,13 @@ LncvStorageClass	g_clLncvStorage = LncvStorageClass();
 //
 #define	MIN_SEND_DELAY_TIME				 5
 #define DEFAULT_SEND_DELAY_TIME			10
+#define DEFAULT_BROADCAST_SLOT			BROADCAST_BURST_TIME( DEFAULT_SEND_DELAY_TIME )
+#define DEFAULT_REPORT_WINDOW			50
+
+//----------------------------------------------------------------------
+//	debounce samples: value = fall * 10 + rise
+//
+#define MAX_SAMPLES_VALUE				77
 
 //----------------------------------------------------------------------
 //	configuration masks
@@ -141,6 +276,61 @@ LncvStorageClass	g_clLncvStorage = LncvStorageClass();
 #define CONFIG_ACTIVE_GREEN		0x0001
 
 
+//==========================================================================
+//
+//		I N L I N E   F U N C T I O N S
+//
+//==========================================================================
+
+//**********************************************************************
+//	Div10
+//----------------------------------------------------------------------
+//	returns value / 10 and the remainder in 'pusRest'
+//	The ATmega has no division instruction, the multiplication with
+//	0xCCCD / 2^19 gives the same result for all 16 bit values.
+//
+static inline uint16_t Div10( uint16_t uiValue, uint8_t *pusRest )
+{
+	uint16_t	uiResult = (uint16_t)(((uint32_t)uiValue * 0xCCCD) >> 19);
+
+	*pusRest = (uint8_t)(uiValue - (uiResult << 3) - (uiResult << 1));
+
+	return( uiResult );
+}
+
+
+//==========================================================================
+//
+//		I N T E R R U P T S
+//
+//==========================================================================
+
+//**********************************************************************
+//	EEPROM ready
+//----------------------------------------------------------------------
+//	occurs as long as the EEPROM is ready and the interrupt is
+//	enabled (EERIE), so the interrupt is only enabled while there
+//	is something to write.
+//	The LNCVs are written first, then the journal of the output
+//	state.
+//
+ISR( EE_READY_vect )
+{
+	if(		!g_clLncvStorage.WriteNextByte()
+		&&	!g_clStateJournal.WriteNextByte()	)
+	{
+		EECR &= ~_BV( EERIE );
+	}
+}
+
+
+//==========================================================================
+//
+//		C L A S S   F U N C T I O N S
+//
+//==========================================================================
+
+
 ////////////////////////////////////////////////////////////////////////
 //	CLASS: LncvStorageClass
 //
@@ -151,31 +341,124 @@ LncvStorageClass	g_clLncvStorage = LncvStorageClass();
 //
 LncvStorageClass::LncvStorageClass()
 {
+	m_usWriteHead	= 0;
+	m_usWriteTail	= 0;
+	m_bWriting		= false;
+	m_bCrcPending	= false;
+	m_bRejected		= false;
+	m_uiCrc			= 0;
+	m_usWriteLncv	= 0;
+	m_usWriteByte	= 0;
+	m_uiWriteValue	= 0;
+
+	for( uint8_t idx = 0 ; idx < sizeof( m_arusQueued ) ; idx++ )
+	{
+		m_arusQueued[ idx ] = 0;
+	}
+}
+
+
+//**********************************************************************
+//	LoadLNCVs
+//----------------------------------------------------------------------
+//	reads all LNCVs from the EEPROM into RAM
+//	(the LNCV n is stored at the EEPROM address 2 * n)
+//
+void LncvStorageClass::LoadLNCVs( void )
+{
+	eeprom_read_block( m_aruiLncv, (const void *)0, sizeof( m_aruiLncv ) );
+}
+
+
+//**********************************************************************
+//	CalcCRC
+//----------------------------------------------------------------------
+//	returns the CRC of all LNCVs in RAM
+//	(in the order of the bytes in the EEPROM)
+//
+uint16_t LncvStorageClass::CalcCRC( void )
+{
+	const uint8_t *	pusByte	= (const uint8_t *)m_aruiLncv;
+	uint16_t		uiCrc	= 0xFFFF;
+
+	for( uint8_t idx = 0 ; idx < sizeof( m_aruiLncv ) ; idx++ )
+	{
+		uiCrc = _crc16_update( uiCrc, pusByte[ idx ] );
+	}
+
+	return( uiCrc );
 }
 
 
 //**********************************************************************
 //	CheckEEPROM
 //----------------------------------------------------------------------
-//	This function checks if the EEPROM is empty (0xFF in the cells).
-//	If so, then the EEPROM will be filled with default config infos
-//	and all addresses will be set to zero.
+//	This function reads all LNCVs from the EEPROM and checks them.
+//	-	the EEPROM is empty (0xFF in the cells) or the module address
+//		is '0': the EEPROM will be filled with default config infos
+//		and all addresses will be set to zero.
+//	-	the CRC is wrong: the image is rejected and the EEPROM will
+//		be filled with the default values as well. Otherwise the
+//		board would send messages to wrong addresses.
+//		An image of a version before LNCV_CRC_VERSION has no CRC,
+//		it is taken over and gets its CRC with the new version
+//		number. The LNCVs that were added with the CRC version
+//		(broadcast slot, report window) get their default values.
 //
 void LncvStorageClass::CheckEEPROM( uint16_t uiVersionNumber )
 {
-	uint16_t	uiAddress	= ReadLNCV( LNCV_ADR_MODULE_ADDRESS );
-	uint16_t	uiArticle	= ReadLNCV( LNCV_ADR_ARTIKEL_NUMMER );
-	uint8_t		idx			= LNCV_ADR_LAST_DELAY_ADDRESS;
+	uint16_t	uiAddress;
+	uint16_t	uiArticle;
+	uint16_t	uiStoredCrc;
+	bool		bDefault	= false;
+	uint8_t		idx			= LNCV_ADR_LAST_SAMPLES_ADDRESS;
+
+	LoadLNCVs();
 
+	m_uiCrc		= CalcCRC();
+	uiStoredCrc	= eeprom_read_word( (const uint16_t *)LNCV_CRC_ADDRESS );
+
+	uiAddress	= ReadLNCV( LNCV_ADR_MODULE_ADDRESS );
+	uiArticle	= ReadLNCV( LNCV_ADR_ARTIKEL_NUMMER );
 
 #ifdef DEBUGGING_PRINTOUT
 	g_clDebugging.PrintStorageCheck( uiAddress, uiArticle );
 #endif
 
 	if( (0xFFFF == uiAddress) || (0x0000 == uiAddress) )
+	{
+		//----	the EEPROM is empty  --------------------------------
+		bDefault = true;
+	}
+	else if( uiStoredCrc != m_uiCrc )
+	{
+		if(		(ARTIKEL_NUMMER != uiArticle)
+			||	(LNCV_CRC_VERSION <= (ReadLNCV( LNCV_ADR_VERSION_NUMBER ) % 10000)) )
+		{
+			//----	the image is corrupted  ---------------------------
+			m_bRejected	= true;
+			bDefault	= true;
+
+#ifdef DEBUGGING_PRINTOUT
+			g_clDebugging.PrintStorageCorrupt( uiStoredCrc, m_uiCrc );
+#endif
+		}
+		else
+		{
+			//----	image of an older version, write the CRC  -------
+			//		LNCV 5 and 6 were not used before, they hold '0'
+			//
+			WriteLNCV( LNCV_ADR_BROADCAST_SLOT, DEFAULT_BROADCAST_SLOT );	//	Broadcast Slot
+			WriteLNCV( LNCV_ADR_REPORT_WINDOW, DEFAULT_REPORT_WINDOW );	//	Report Window
+
+			WriteCRC();
+		}
+	}
+
+	if( bDefault )
 	{
 		//----------------------------------------------------------
-		//	the EEPROM is empty, so write default config info ...
+		//	write default config info ...
 		//
 
 #ifdef DEBUGGING_PRINTOUT
@@ -188,46 +471,108 @@ void LncvStorageClass::CheckEEPROM( uint16_t uiVersionNumber )
 
 		WriteLNCV( LNCV_ADR_CONFIGURATION, 0 );						//	no configuration
 		WriteLNCV( LNCV_ADR_SEND_DELAY, DEFAULT_SEND_DELAY_TIME );	//	Send Delay Timer
+		WriteLNCV( LNCV_ADR_BROADCAST_SLOT, DEFAULT_BROADCAST_SLOT );	//	Broadcast Slot
+		WriteLNCV( LNCV_ADR_REPORT_WINDOW, DEFAULT_REPORT_WINDOW );	//	Report Window
 		
 		//----------------------------------------------------------
-		//	set all I/O addresses and delay times to '0'
+		//	set all I/O addresses, delay times and samples to '0'
 		//
-		while( LNCV_ADR_SEND_DELAY < idx )
+		while( LNCV_ADR_REPORT_WINDOW < idx )
 		{
 			WriteLNCV( idx, 0 );
 			idx--;
 		}
+
+		//----------------------------------------------------------
+		//	... and the CRC in any case, the rejected image may
+		//	already hold the default values (e.g. power was lost
+		//	before the CRC was written)
+		//
+		WriteCRC();
 	}
 	else
 	{
 		WriteLNCV( LNCV_ADR_VERSION_NUMBER, uiVersionNumber );
 	}
 
+#ifndef FAST_BOOT
 	delay( 250 );
+#endif
 }
 
 
 //**********************************************************************
 //	Init
 //----------------------------------------------------------------------
-//	This function will read the saved informations from the EEPROM.
+//	This function takes over the LNCVs read from the EEPROM.
 //
 void LncvStorageClass::Init( void )
 {
-    uint16_t    uiHelper;
-    uint16_t    uiMask      = 0x0001;
-
-
 #ifdef DEBUGGING_PRINTOUT
 	g_clDebugging.PrintStorageRead();
 #endif
 
+	Decode();
+}
+
+
+//**********************************************************************
+//	Reload
+//----------------------------------------------------------------------
+//	This function takes over the LNCVs after programming.
+//	The actual configuration of the I/O pins is kept as shadow and
+//	compared with the new one.
+//	Returns a bit mask of the I/O pins whose role (input/output,
+//	switch/sensor, active state) or address has changed.
+//
+uint16_t LncvStorageClass::Reload( void )
+{
+	io_config_t	arShadow[ IO_NUMBERS ];
+	uint16_t	uiChanged	= 0x0000;
+	uint16_t	uiMask		= 0x0001;
+
+	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
+	{
+		arShadow[ idx ] = m_arIOConfig[ idx ];
+	}
+
+	Decode();
+
+	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
+	{
+		if(		(arShadow[ idx ].uiAddress != m_arIOConfig[ idx ].uiAddress)
+			||	(arShadow[ idx ].usMode    != m_arIOConfig[ idx ].usMode)		)
+		{
+			uiChanged |= uiMask;
+		}
+
+		uiMask <<= 1;
+	}
+
+	return( uiChanged );
+}
+
+
+//**********************************************************************
+//	Decode
+//----------------------------------------------------------------------
+//	This function decodes the LNCVs (in RAM) into the configuration
+//	of the I/O pins.
+//
+void LncvStorageClass::Decode( void )
+{
+	io_config_t *	pConfig;
+	uint16_t		uiHelper;
+	uint16_t		uiMask		= 0x0001;
+	uint8_t			usRest;
+
+
 	//--------------------------------------------------------------
 	//	read config information
 	//
-	m_uiArticleNumber	= ReadLNCV( LNCV_ADR_ARTIKEL_NUMMER );
-	m_uiModuleAddress	= ReadLNCV( LNCV_ADR_MODULE_ADDRESS );
-//	m_uiConfiguration	= ReadLNCV( LNCV_ADR_CONFIGURATION );
+	m_uiArticleNumber	= m_aruiLncv[ LNCV_ADR_ARTIKEL_NUMMER ];
+	m_uiModuleAddress	= m_aruiLncv[ LNCV_ADR_MODULE_ADDRESS ];
+//	m_uiConfiguration	= m_aruiLncv[ LNCV_ADR_CONFIGURATION ];
 	m_uiOutputs			= 0x0000;
 	m_uiSensors			= 0x0000;
 	m_uiInverse			= 0x0000;
@@ -236,7 +581,7 @@ void LncvStorageClass::Init( void )
 	//	read send delay time
 	//	and make sure it is not shorter than MIN_SEND_DELAY_TIME ms
 	//
-	m_uiSendDelay = ReadLNCV( LNCV_ADR_SEND_DELAY );
+	m_uiSendDelay = m_aruiLncv[ LNCV_ADR_SEND_DELAY ];
 
 	if( MIN_SEND_DELAY_TIME > m_uiSendDelay )
 	{
@@ -244,43 +589,208 @@ void LncvStorageClass::Init( void )
 	}
 
 	//--------------------------------------------------------------
-	//	read IO addresses and delay times
-    //  for the IO addresses find out if it is
-    //      input or output
-    //      switch or sensor
-    //      react on RED or GREEN
+	//	read broadcast slot width
+	//	and make sure a slot holds the burst of one board
+	//	('0': no waiting)
+	//
+	m_uiBroadcastSlot = m_aruiLncv[ LNCV_ADR_BROADCAST_SLOT ];
+
+	if( 0 < m_uiBroadcastSlot )
+	{
+		uint32_t	ulBurst	= BROADCAST_BURST_TIME( (uint32_t)m_uiSendDelay );
+
+		if( ulBurst > m_uiBroadcastSlot )
+		{
+			m_uiBroadcastSlot = (0xFFFF < ulBurst) ? 0xFFFF : (uint16_t)ulBurst;
+		}
+	}
+
+	m_uiReportWindow	= m_aruiLncv[ LNCV_ADR_REPORT_WINDOW ];
+
+	//--------------------------------------------------------------
+	//	decode IO addresses, delay times and debounce samples
+	//	for the IO addresses find out if it is
+	//		input or output
+	//		switch or sensor
+	//		react on RED or GREEN
 	//
 	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
 	{
-		m_aruiOffDelay[ idx ]	= ReadLNCV( LNCV_ADR_FIRST_DELAY_ADDRESS + idx );
-
-        uiHelper				 = ReadLNCV( LNCV_ADR_FIRST_IO_ADDRESS + idx );
-        m_aruiAddress[ idx ]	 = uiHelper / 10;
-		uiHelper				-= (m_aruiAddress[ idx ] * 10);
-
-        if( 0 == (CONFIG_INPUT & uiHelper) )
-        {
-            //------------------------------------------------------
-            //  this is an output
-            //
-            m_uiOutputs |= uiMask;
-        }
-
-        if( CONFIG_SENSOR & uiHelper )
-        {
-            //------------------------------------------------------
-            //  this is a sensor
-            //
-            m_uiSensors |= uiMask;
-        }
-
-        if( 0 == (CONFIG_ACTIVE_GREEN & uiHelper) )
-        {
-            m_uiInverse |= uiMask;
-        }
-
-        uiMask <<= 1;
+		pConfig = &m_arIOConfig[ idx ];
+
+		pConfig->uiOffDelay	= m_aruiLncv[ LNCV_ADR_FIRST_DELAY_ADDRESS + idx ];
+
+		//----------------------------------------------------------
+		//	debounce samples, the LNCVs are not set (0xFFFF) if the
+		//	EEPROM was written by an older version
+		//
+		uiHelper = m_aruiLncv[ LNCV_ADR_FIRST_SAMPLES_ADDRESS + idx ];
+
+		if( MAX_SAMPLES_VALUE < uiHelper )
+		{
+			uiHelper = 0;
+		}
+
+		uiHelper			= Div10( uiHelper, &usRest );
+		pConfig->usSamples	= (uint8_t)(uiHelper << 4) | usRest;
+
+		pConfig->uiAddress	= Div10( m_aruiLncv[ LNCV_ADR_FIRST_IO_ADDRESS + idx ], &usRest );
+		pConfig->usMode		= usRest;
+
+		if( 0 == (CONFIG_INPUT & usRest) )
+		{
+			//------------------------------------------------------
+			//	this is an output
+			//
+			m_uiOutputs |= uiMask;
+		}
+
+		if( CONFIG_SENSOR & usRest )
+		{
+			//------------------------------------------------------
+			//	this is a sensor
+			//
+			m_uiSensors |= uiMask;
+		}
+
+		if( 0 == (CONFIG_ACTIVE_GREEN & usRest) )
+		{
+			m_uiInverse |= uiMask;
+		}
+
+		uiMask <<= 1;
 	}
+
+	BuildAddressIndex();
+}
+
+
+//**********************************************************************
+//	BuildAddressIndex
+//----------------------------------------------------------------------
+//	This function collects all addresses of the outputs in the
+//	address index. The index is sorted by the key (address and
+//	message type), so it can be searched binary.
+//	Outputs with the same address and message type share one entry.
+//
+void LncvStorageClass::BuildAddressIndex( void )
+{
+	uint16_t	uiMask		= 0x0001;
+	uint16_t	uiKey;
+	uint8_t		usPos;
+
+	m_usAddressCount = 0;
+
+	for( uint8_t idx = 0 ; idx < sizeof( m_arusAddressFilter ) ; idx++ )
+	{
+		m_arusAddressFilter[ idx ] = 0;
+	}
+
+	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
+	{
+		if( (m_uiOutputs & uiMask) && (0 < m_arIOConfig[ idx ].uiAddress) )
+		{
+			uiKey = m_arIOConfig[ idx ].uiAddress << 1;
+
+			if( m_uiSensors & uiMask )
+			{
+				uiKey |= 0x0001;
+			}
+
+			//------------------------------------------------------
+			//	find the place for the key
+			//
+			usPos = 0;
+
+			while( (usPos < m_usAddressCount) && (m_arAddressIndex[ usPos ].uiKey < uiKey) )
+			{
+				usPos++;
+			}
+
+			if( (usPos == m_usAddressCount) || (m_arAddressIndex[ usPos ].uiKey != uiKey) )
+			{
+				//--------------------------------------------------
+				//	new key, so make room for it
+				//
+				for( uint8_t usMove = m_usAddressCount ; usMove > usPos ; usMove-- )
+				{
+					m_arAddressIndex[ usMove ] = m_arAddressIndex[ usMove - 1 ];
+				}
+
+				m_arAddressIndex[ usPos ].uiKey		= uiKey;
+				m_arAddressIndex[ usPos ].uiPinMask	= 0x0000;
+				m_arAddressIndex[ usPos ].uiInverse	= 0x0000;
+				m_usAddressCount++;
+
+				m_arusAddressFilter[ (uiKey >> 3) & 0x07 ] |= _BV( uiKey & 0x07 );
+			}
+
+			m_arAddressIndex[ usPos ].uiPinMask |= uiMask;
+			m_arAddressIndex[ usPos ].uiInverse |= (m_uiInverse & uiMask);
+		}
+
+		uiMask <<= 1;
+	}
+}
+
+
+//**********************************************************************
+//	FindOutputAddress
+//----------------------------------------------------------------------
+//	This function returns a bit mask of all outputs that use the
+//	given address for the given message type.
+//	The bits of the outputs that work inverse will be returned
+//	in 'puiInverse'.
+//	If the address is not used by an output '0' will be returned.
+//
+uint16_t LncvStorageClass::FindOutputAddress(	bool isSensor,
+												uint16_t uiAddress,
+												uint16_t *puiInverse	)
+{
+	uint16_t	uiKey	= uiAddress << 1;
+	uint8_t		usLow	= 0;
+	uint8_t		usHigh	= m_usAddressCount;
+	uint8_t		usMid;
+
+	if( isSensor )
+	{
+		uiKey |= 0x0001;
+	}
+
+	//--------------------------------------------------------------
+	//	most of the messages are not for us,
+	//	so check the bit field first
+	//
+	if( 0 == (m_arusAddressFilter[ (uiKey >> 3) & 0x07 ] & _BV( uiKey & 0x07 )) )
+	{
+		return( 0x0000 );
+	}
+
+	//--------------------------------------------------------------
+	//	binary search
+	//
+	while( usLow < usHigh )
+	{
+		usMid = (usLow + usHigh) >> 1;
+
+		if( m_arAddressIndex[ usMid ].uiKey < uiKey )
+		{
+			usLow = usMid + 1;
+		}
+		else
+		{
+			usHigh = usMid;
+		}
+	}
+
+	if( (usLow < m_usAddressCount) && (m_arAddressIndex[ usLow ].uiKey == uiKey) )
+	{
+		*puiInverse = m_arAddressIndex[ usLow ].uiInverse;
+
+		return( m_arAddressIndex[ usLow ].uiPinMask );
+	}
+
+	return( 0x0000 );
 }
 
 
@@ -289,7 +799,7 @@ void LncvStorageClass::Init( void )
 //
 bool LncvStorageClass::IsValidLNCVAddress( uint16_t Adresse )
 {
-	if( LNCV_ADR_LAST_DELAY_ADDRESS >= Adresse )
+	if( LNCV_ADR_LAST_SAMPLES_ADDRESS >= Adresse )
 	{
 		return( true );
 	}
@@ -300,35 +810,200 @@ bool LncvStorageClass::IsValidLNCVAddress( uint16_t Adresse )
 
 //**********************************************************************
 //	ReadLNCV
+//----------------------------------------------------------------------
+//	returns the value from RAM
 //
 uint16_t LncvStorageClass::ReadLNCV( uint16_t Adresse )
 {
-	uint16_t	value;
+	if( LNCV_COUNT > Adresse )
+	{
+		return( m_aruiLncv[ Adresse ] );
+	}
+
+	return( 0xFFFF );
+}
+
+
+//**********************************************************************
+//	WriteLNCV
+//----------------------------------------------------------------------
+//	changes the value in RAM and puts the LNCV into the write queue
+//	(if it is not already waiting there). Only if the queue is full
+//	the function has to wait for the EEPROM.
+//	The new CRC is calculated with the interrupts enabled, it will
+//	be written after all queued LNCVs.
+//
+void LncvStorageClass::WriteLNCV( uint16_t Address, uint16_t Value )
+{
+	uint16_t	uiCrc;
+	uint8_t		usMask	= _BV( Address & 0x07 );
+	uint8_t		usNext;
+	uint8_t		usSREG;
+
+	if( (LNCV_COUNT <= Address) || (m_aruiLncv[ Address ] == Value) )
+	{
+		return;
+	}
 
 	//--------------------------------------------------------------
-	//	because of uint16 values the address has to be shifted
-	//	by '1' (this will double the address).
+	//	wait for space in the queue
+	//	(the head is only changed here, the tail by the interrupt)
 	//
-	value = eeprom_read_word( (uint16_t *)(Adresse << 1) );
+	usNext = (m_usWriteHead + 1) & (LNCV_WRITE_QUEUE_SIZE - 1);
+
+	while(		!(m_arusQueued[ Address >> 3 ] & usMask)
+			&&	(usNext == m_usWriteTail)					)
+	{
+		delay( 1 );
+	}
+
+	usSREG = SREG;
+	cli();
+
+	if( !(m_arusQueued[ Address >> 3 ] & usMask) )
+	{
+		m_arusWriteQueue[ m_usWriteHead ]	 = (uint8_t)Address;
+		m_arusQueued[ Address >> 3 ]		|= usMask;
+		m_usWriteHead						 = usNext;
+	}
+
+	m_aruiLncv[ Address ] = Value;
 
-	return( value );
+	SREG = usSREG;
+
+	uiCrc = CalcCRC();
+
+	cli();
+
+	m_uiCrc			 = uiCrc;
+	m_bCrcPending	 = true;
+	EECR			|= _BV( EERIE );
+
+	SREG = usSREG;
 }
 
 
 //**********************************************************************
-//	WriteLNCV
+//	WriteCRC
+//----------------------------------------------------------------------
+//	The CRC of the LNCVs is written, even if no LNCV has changed.
 //
-void LncvStorageClass::WriteLNCV( uint16_t Address, uint16_t Value )
+void LncvStorageClass::WriteCRC( void )
+{
+	uint16_t	uiCrc	= CalcCRC();
+	uint8_t		usSREG	= SREG;
+
+	cli();
+
+	m_uiCrc			 = uiCrc;
+	m_bCrcPending	 = true;
+	EECR			|= _BV( EERIE );
+
+	SREG = usSREG;
+}
+
+
+//**********************************************************************
+//	WriteNextByte
+//----------------------------------------------------------------------
+//	This function is called by the EEPROM ready interrupt.
+//	It starts the write of the next byte. The value of an LNCV is
+//	taken when its first byte is written, so a later change of
+//	the LNCV will put it into the queue again.
+//	If the queue is empty, the CRC is written (if it has changed).
+//	Returns false if there is nothing to write.
+//
+//	ATTENTION: only to be called by the interrupt
+//
+bool LncvStorageClass::WriteNextByte( void )
 {
+	uint8_t	usValue;
+
+	if( !m_bWriting )
+	{
+		if( m_usWriteTail != m_usWriteHead )
+		{
+			m_usWriteLncv	 = m_arusWriteQueue[ m_usWriteTail ];
+			m_usWriteTail	 = (m_usWriteTail + 1) & (LNCV_WRITE_QUEUE_SIZE - 1);
+
+			m_arusQueued[ m_usWriteLncv >> 3 ] &= ~_BV( m_usWriteLncv & 0x07 );
+
+			m_uiWriteValue	 = m_aruiLncv[ m_usWriteLncv ];
+		}
+		else if( m_bCrcPending )
+		{
+			m_usWriteLncv	 = LNCV_CRC_INDEX;
+			m_uiWriteValue	 = m_uiCrc;
+			m_bCrcPending	 = false;
+		}
+		else
+		{
+			return( false );
+		}
+
+		m_usWriteByte	 = 0;
+		m_bWriting		 = true;
+	}
+
+	if( 0 == m_usWriteByte )
+	{
+		usValue = (uint8_t)(m_uiWriteValue & 0xFF);
+	}
+	else
+	{
+		usValue		= (uint8_t)(m_uiWriteValue >> 8);
+		m_bWriting	= false;
+	}
+
 	//--------------------------------------------------------------
-	//	because of uint16 values the address has to be shifted
-	//	by '1' (this will double the address).
+	//	the EEPROM is ready, so the update only starts the write
+	//	(and skips it if the byte is already there)
 	//
-	uint16_t *	puiAdr	= (uint16_t *)(Address << 1);
-	uint16_t	uiValue	= eeprom_read_word( puiAdr );
-	
-	if( uiValue != Value )
+	eeprom_update_byte( (uint8_t *)((m_usWriteLncv << 1) + m_usWriteByte), usValue );
+
+	m_usWriteByte++;
+
+	return( true );
+}
+
+
+//**********************************************************************
+//	GetPendingWrites
+//----------------------------------------------------------------------
+//	returns the number of LNCVs that are not yet completely written
+//	into the EEPROM. If the power goes off while this is not '0',
+//	the EEPROM does not hold the last configuration.
+//
+uint8_t LncvStorageClass::GetPendingWrites( void )
+{
+	uint8_t	usPending;
+	uint8_t	usSREG	= SREG;
+
+	cli();
+
+	usPending = (m_usWriteHead - m_usWriteTail) & (LNCV_WRITE_QUEUE_SIZE - 1);
+
+	if( m_bWriting || m_bCrcPending || !eeprom_is_ready() )
+	{
+		usPending++;
+	}
+
+	SREG = usSREG;
+
+	return( usPending );
+}
+
+
+//**********************************************************************
+//	Flush
+//----------------------------------------------------------------------
+//	waits until all LNCVs are written into the EEPROM
+//	(e.g. before a reset)
+//
+void LncvStorageClass::Flush( void )
+{
+	while( 0 < GetPendingWrites() )
 	{
-		eeprom_write_word( puiAdr, Value );
+		delay( 1 );
 	}
 }
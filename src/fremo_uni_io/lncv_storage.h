@@ -12,6 +12,116 @@
 //#	without gaps. This makes it very easy to read and write the variables
 //#	with a tool.
 //#
+//#	All LNCVs are held in RAM. A write changes the RAM and puts the
+//#	LNCV into a queue, the EEPROM ready interrupt writes the queued
+//#	LNCVs into the EEPROM in the background.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	16		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	BROADCAST_BURST_TIME(): min slot width of LNCV 5
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	15		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new function WriteCRC()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	14		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	addresses of the read-only LNCVs of the loop profiler
+//#			(LNCV 120 .., compile option LOOP_PROFILING)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	13		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	addresses of the read-only LNCVs with the runtime
+//#			counters (LNCV 100 ..)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	12		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add report window (LNCV 6)
+//#			new function
+//#				GetReportWindow()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	11		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add slot width for the start up broadcast (LNCV 5)
+//#			new function
+//#				GetBroadcastDelay()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	10		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new function Reload()
+//#			takes over changed LNCVs without a reset
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	9		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the LNCVs are protected by a CRC, that is stored in the
+//#			EEPROM behind the LNCVs (it is not an LNCV itself)
+//#			an image with a wrong CRC is rejected
+//#			new function
+//#				IsImageRejected()
+//#		-	the configuration of each I/O pin is held in one
+//#			descriptor (io_config_t)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	8		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	WriteNextByte() returns false if there is nothing to write
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	7		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	RAM mirror of all LNCVs and write queue for the EEPROM
+//#			new functions
+//#				WriteNextByte()
+//#				GetPendingWrites()
+//#				Flush()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	6		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add debounce samples (LNCV 51 .. 66)
+//#			new functions
+//#				GetIOFallSamples()
+//#				GetIORiseSamples()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	5		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add address index for the outputs
+//#			new function
+//#				FindOutputAddress()
+//#
 //#-------------------------------------------------------------------------
 //#
 //#	File version:	4		vom: 27.01.2023
@@ -79,11 +189,123 @@
 #define LNCV_ADR_VERSION_NUMBER			2
 #define LNCV_ADR_CONFIGURATION			3
 #define LNCV_ADR_SEND_DELAY				4
+#define LNCV_ADR_BROADCAST_SLOT			5
+#define LNCV_ADR_REPORT_WINDOW			6
 
 #define LNCV_ADR_FIRST_IO_ADDRESS		11
 #define LNCV_ADR_LAST_IO_ADDRESS		26
 #define LNCV_ADR_FIRST_DELAY_ADDRESS	31
 #define LNCV_ADR_LAST_DELAY_ADDRESS		46
+#define LNCV_ADR_FIRST_SAMPLES_ADDRESS	51
+#define LNCV_ADR_LAST_SAMPLES_ADDRESS	66
+
+#define LNCV_COUNT						(LNCV_ADR_LAST_SAMPLES_ADDRESS + 1)
+
+
+//----------------------------------------------------------------------
+//	read-only LNCVs with the runtime counters of the board
+//	they are not stored in the EEPROM but read from the running
+//	firmware (see MyLoconetClass::ReadCounter())
+//	all counters have 16 bit and wrap around
+//
+#define LNCV_ADR_FIRST_COUNTER			100
+#define LNCV_ADR_RX_PACKETS				100		//	packets received
+#define LNCV_ADR_RX_MATCHED				101		//	packets for our outputs
+#define LNCV_ADR_TX_MESSAGES			102		//	messages sent
+#define LNCV_ADR_TX_FAILED				103		//	messages not sent (bus error)
+#define LNCV_ADR_SEND_QUEUE_COUNT		104		//	messages in the send queue
+#define LNCV_ADR_SEND_QUEUE_MAX			105		//	max messages in the send queue
+#define LNCV_ADR_SUPPRESSED_REPORTS		106		//	reports within the report window
+#define LNCV_ADR_SUPPRESSED_ECHOES		107		//	echoes of our own messages
+#define LNCV_ADR_UPTIME_LOW				108		//	uptime in s, low word
+#define LNCV_ADR_UPTIME_HIGH			109		//	uptime in s, high word
+#define LNCV_ADR_LOOP_TIME_MAX			110		//	max time of 'loop()' in us
+#define LNCV_ADR_FIRST_BOOT_TIME		111		//	end of the start up phases in ms
+#define LNCV_ADR_LAST_COUNTER			114		//	(see boot_phases.h)
+
+
+//----------------------------------------------------------------------
+//	read-only LNCVs of the loop profiler (see loop_profiler.h)
+//	only with the compile option LOOP_PROFILING
+//	for each phase of 'loop()' three LNCVs: min, avg, max in us
+//	histogram: number of loops in each time class
+//
+#define LNCV_ADR_FIRST_PROFILE			120		//	phase 0 min, avg, max, phase 1 ..
+#define LNCV_ADR_PROFILE_LOOPS_LOW		138		//	loops measured, low word
+#define LNCV_ADR_PROFILE_LOOPS_HIGH		139		//	loops measured, high word
+#define LNCV_ADR_FIRST_HISTOGRAM		140		//	< 64 us
+#define LNCV_ADR_LAST_PROFILE			147		//	>= 4 ms
+
+
+//----------------------------------------------------------------------
+//	CRC of all LNCVs
+//	it is written like an additional LNCV behind the last one,
+//	but it is not accessible by the LNCV commands
+//	LNCV_CRC_VERSION is the first version (without PLATINE_VERSION)
+//	that writes the CRC, images of older versions have none
+//
+#define LNCV_CRC_INDEX					LNCV_COUNT
+#define LNCV_CRC_ADDRESS				(LNCV_CRC_INDEX * 2)
+#define LNCV_CRC_VERSION				703
+
+
+//----------------------------------------------------------------------
+//	the boards send the state of their inputs after power up in
+//	different time slots, the slot is given by the lower bits of
+//	the module address (BROADCAST_SLOT_COUNT is a power of 2)
+//
+//	LNCV 5 is the slot width in ms. A slot must hold the burst of
+//	one board: each I/O pin may send a switch request and its
+//	release, one message each send delay (LNCV 4). A smaller slot
+//	width (but not '0') is raised to BROADCAST_BURST_TIME().
+//
+#define BROADCAST_SLOT_COUNT			32
+#define BROADCAST_BURST_TIME( delay )	(IO_NUMBERS * 2 * (delay))
+
+
+//----------------------------------------------------------------------
+//	number of LNCVs that can wait for the EEPROM (power of 2)
+//
+#define LNCV_WRITE_QUEUE_SIZE			16
+
+
+//----------------------------------------------------------------------
+//	configuration of one I/O pin
+//	decoded from the LNCVs by Init()
+//
+//	uiAddress	Loconet address (LNCV value / 10)
+//	uiOffDelay	off delay time in ms
+//	usMode		CONFIG_xxx bits (LNCV value % 10)
+//	usSamples	debounce samples: fall << 4 | rise
+//
+typedef struct io_config
+{
+	uint16_t	uiAddress;
+	uint16_t	uiOffDelay;
+	uint8_t		usMode;
+	uint8_t		usSamples;
+
+}	io_config_t;
+
+
+//----------------------------------------------------------------------
+//	entry of the address index
+//	the index holds one entry for each address (and message type)
+//	that is used by outputs. If one address is used by more than
+//	one output, all these outputs are collected in 'uiPinMask'.
+//
+//	uiKey		(address << 1) | 1		sensor message
+//				(address << 1) | 0		switch message
+//	uiPinMask	bit set for each output using this address
+//	uiInverse	bit set for each of these outputs working inverse
+//
+typedef struct address_index
+{
+	uint16_t	uiKey;
+	uint16_t	uiPinMask;
+	uint16_t	uiInverse;
+
+}	address_index_t;
 
 
 ////////////////////////////////////////////////////////////////////////
@@ -101,9 +323,28 @@ class LncvStorageClass
 		//
 		void		CheckEEPROM( uint16_t uiVersionNumber );
 		void		Init( void );
+		uint16_t	Reload( void );
 		bool		IsValidLNCVAddress( uint16_t Adresse );
 		uint16_t	ReadLNCV(  uint16_t Adresse );
 		void		WriteLNCV( uint16_t Adresse, uint16_t Value );
+		uint16_t	FindOutputAddress(	bool isSensor, uint16_t uiAddress,
+										uint16_t *puiInverse				);
+
+		//----------------------------------------------------------
+		//	EEPROM write queue
+		//
+		bool		WriteNextByte( void );
+		uint8_t		GetPendingWrites( void );
+		void		Flush( void );
+
+		//----------------------------------------------------------
+		//	true if the LNCVs in the EEPROM had a wrong CRC and
+		//	were replaced by the default values
+		//
+		inline bool IsImageRejected( void )
+		{
+			return( m_bRejected );
+		};
 
 		//----------------------------------------------------------
 		//
@@ -126,6 +367,28 @@ class LncvStorageClass
 			return( m_uiSendDelay );
 		};
 
+		//----------------------------------------------------------
+		//	time in ms, in which the same report (address, message
+		//	type and direction) is not sent again, even by another
+		//	input (LNCV 6, '0': no suppression)
+		//
+		inline uint16_t GetReportWindow( void )
+		{
+			return( m_uiReportWindow );
+		};
+
+		//----------------------------------------------------------
+		//	time in ms from the end of the start up to the
+		//	broadcast of the inputs: time slot of the module
+		//	address * slot width (LNCV 5, at least one burst,
+		//	'0': no waiting)
+		//
+		inline uint32_t GetBroadcastDelay( void )
+		{
+			return(		(uint32_t)(m_uiModuleAddress & (BROADCAST_SLOT_COUNT - 1))
+					*	m_uiBroadcastSlot											);
+		};
+
 		//----------------------------------------------------------
 		//
 		inline uint16_t	GetAsOutputs( void )
@@ -162,7 +425,7 @@ class LncvStorageClass
 
 			if( IO_NUMBERS > idx )
 			{
-				uiAddress = m_aruiAddress[ idx ];
+				uiAddress = m_arIOConfig[ idx ].uiAddress;
 			}
 			
 			return( uiAddress );
@@ -176,22 +439,96 @@ class LncvStorageClass
 
 			if( IO_NUMBERS > idx )
 			{
-				uiOffDelay = m_aruiOffDelay[ idx ];
+				uiOffDelay = m_arIOConfig[ idx ].uiOffDelay;
 			}
 			
 			return( uiOffDelay );
 		}
 
+		//----------------------------------------------------------
+		//	number of samples needed for a falling edge (pin goes
+		//	low) resp. a rising edge (pin goes high) of an input
+		//	'0' means default
+		//
+		inline uint8_t	GetIOFallSamples( uint8_t idx )
+		{
+			uint8_t	usSamples = 0;
+
+			if( IO_NUMBERS > idx )
+			{
+				usSamples = m_arIOConfig[ idx ].usSamples >> 4;
+			}
+
+			return( usSamples );
+		}
+
+		inline uint8_t	GetIORiseSamples( uint8_t idx )
+		{
+			uint8_t	usSamples = 0;
+
+			if( IO_NUMBERS > idx )
+			{
+				usSamples = m_arIOConfig[ idx ].usSamples & 0x0F;
+			}
+
+			return( usSamples );
+		}
+
 	private:
 		uint16_t	m_uiArticleNumber;
 		uint16_t	m_uiModuleAddress;
 //		uint16_t	m_uiConfiguration;
 		uint16_t	m_uiSendDelay;
+		uint16_t	m_uiBroadcastSlot;
+		uint16_t	m_uiReportWindow;
 		uint16_t	m_uiOutputs;
 		uint16_t	m_uiSensors;
 		uint16_t	m_uiInverse;
-		uint16_t	m_aruiAddress[  IO_NUMBERS ];
-		uint16_t	m_aruiOffDelay[ IO_NUMBERS ];
+		io_config_t	m_arIOConfig[ IO_NUMBERS ];
+		bool		m_bRejected;
+
+		//----------------------------------------------------------
+		//	address index, sorted by 'uiKey'
+		//	and a bit field of all used keys (lower 6 bits)
+		//	for a fast rejection of unknown addresses
+		//
+		address_index_t	m_arAddressIndex[ IO_NUMBERS ];
+		uint8_t			m_usAddressCount;
+		uint8_t			m_arusAddressFilter[ 8 ];
+
+		//----------------------------------------------------------
+		//	RAM mirror of the LNCVs
+		//	and the CRC of the mirror
+		//
+		uint16_t		m_aruiLncv[ LNCV_COUNT ];
+		uint16_t		m_uiCrc;
+
+		//----------------------------------------------------------
+		//	EEPROM write queue
+		//	m_arusWriteQueue	numbers of the LNCVs to be written
+		//	m_arusQueued		bit set for each LNCV in the queue
+		//	m_bWriting			the interrupt is writing the LNCV
+		//						m_usWriteLncv with the value
+		//						m_uiWriteValue, m_usWriteByte is
+		//						the next byte to write (0 or 1)
+		//	m_bCrcPending		the CRC has changed, it is written
+		//						when the queue is empty
+		//
+		uint8_t				m_arusWriteQueue[ LNCV_WRITE_QUEUE_SIZE ];
+		volatile uint8_t	m_usWriteHead;
+		volatile uint8_t	m_usWriteTail;
+		uint8_t				m_arusQueued[ (LNCV_COUNT + 7) / 8 ];
+		volatile bool		m_bWriting;
+		volatile bool		m_bCrcPending;
+		uint8_t				m_usWriteLncv;
+		uint8_t				m_usWriteByte;
+		uint16_t			m_uiWriteValue;
+
+		void		LoadLNCVs( void );
+		void		Decode( void );
+		uint16_t	CalcCRC( void );
+		void		WriteCRC( void );
+		void		BuildAddressIndex( void );
 };
 
 
@@ -0,0 +1,257 @@
+//##########################################################################
+//#
+//#		LoopProfilerClass
+//#
+//#	This class measures the time of each phase of 'loop()'
+//#	(see loop_profiler.h).
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Bugfix:
+//#		-	the average of a phase was wrong after an overflow of
+//#			its sum (after some hours), the sums are halved now
+//#			every PROFILE_AVG_LOOPS loops
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include "compile_options.h"
+
+
+#ifdef LOOP_PROFILING
+//**************************************************************************
+//**************************************************************************
+
+
+#include <Arduino.h>
+
+#include "lncv_storage.h"
+#include "loop_profiler.h"
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+static_assert(	(LNCV_ADR_FIRST_PROFILE + (PROFILE_PHASE_COUNT * 3)) <= LNCV_ADR_PROFILE_LOOPS_LOW,
+				"the phases do not fit into the profile LNCVs"	);
+
+static_assert(	(LNCV_ADR_FIRST_HISTOGRAM + PROFILE_HIST_COUNT - 1) == LNCV_ADR_LAST_PROFILE,
+				"the histogram does not fit into the profile LNCVs"	);
+
+
+//==========================================================================
+//
+//		G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+LoopProfilerClass	g_clLoopProfiler	= LoopProfilerClass();
+
+
+//==========================================================================
+//
+//		L O C A L   F U N C T I O N S
+//
+//==========================================================================
+
+//**********************************************************************
+//	CountsToMicros
+//----------------------------------------------------------------------
+//	timer counts to micro seconds, limited to 16 bit
+//
+static inline uint16_t CountsToMicros( uint32_t ulCounts )
+{
+	ulCounts *= CYCLE_COUNTER_US_CLOCK_64;
+
+	return( (0xFFFF < ulCounts) ? 0xFFFF : (uint16_t)ulCounts );
+}
+
+
+//==========================================================================
+//
+//		C L A S S   F U N C T I O N S
+//
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////
+//	CLASS: LoopProfilerClass
+//
+
+//**********************************************************************
+//	Constructor
+//----------------------------------------------------------------------
+//
+LoopProfilerClass::LoopProfilerClass()
+{
+	m_uiStart		= 0;
+	m_uiLast		= 0;
+	m_ulLoops		= 0L;
+	m_ulAvgLoops	= 0L;
+
+	for( uint8_t idx = 0 ; idx < PROFILE_PHASE_COUNT ; idx++ )
+	{
+		m_arPhase[ idx ].uiMin	= 0xFFFF;
+		m_arPhase[ idx ].uiMax	= 0;
+		m_arPhase[ idx ].ulSum	= 0L;
+	}
+
+	for( uint8_t idx = 0 ; idx < PROFILE_HIST_COUNT ; idx++ )
+	{
+		m_arulHistogram[ idx ] = 0L;
+	}
+}
+
+
+//**********************************************************************
+//	Init
+//----------------------------------------------------------------------
+//	Timer 3 with 4 us per count
+//
+void LoopProfilerClass::Init( void )
+{
+	CycleCounterInit( CYCLE_COUNTER_CLOCK_64 );
+}
+
+
+//**********************************************************************
+//	Phase
+//----------------------------------------------------------------------
+//	is called at the end of each phase. The time since the end of
+//	the last phase is added to the statistic of 'usPhase'.
+//	The last phase closes the loop: the whole loop time is added
+//	to the histogram.
+//	Before the sums can overflow, they are halved together with
+//	the number of loops they hold, so the average stays valid
+//	(the older loops get less weight).
+//
+void LoopProfilerClass::Phase( uint8_t usPhase )
+{
+	profile_phase_t *	pPhase	= &m_arPhase[ usPhase ];
+	uint16_t			uiNow	= CycleCounterRead();
+	uint16_t			uiTime	= uiNow - m_uiLast;
+	uint8_t				usClass	= 0;
+
+	m_uiLast = uiNow;
+
+	if( uiTime < pPhase->uiMin )
+	{
+		pPhase->uiMin = uiTime;
+	}
+
+	if( uiTime > pPhase->uiMax )
+	{
+		pPhase->uiMax = uiTime;
+	}
+
+	pPhase->ulSum += uiTime;
+
+	if( (PROFILE_PHASE_COUNT - 1) != usPhase )
+	{
+		return;
+	}
+
+	//--------------------------------------------------------------
+	//	end of the loop
+	//
+	uiTime = (uiNow - m_uiStart) >> PROFILE_HIST_FIRST_SHIFT;
+
+	while( (0 < uiTime) && ((PROFILE_HIST_COUNT - 1) > usClass) )
+	{
+		uiTime >>= 1;
+		usClass++;
+	}
+
+	m_arulHistogram[ usClass ]++;
+	m_ulLoops++;
+
+	if( PROFILE_AVG_LOOPS <= ++m_ulAvgLoops )
+	{
+		for( uint8_t idx = 0 ; idx < PROFILE_PHASE_COUNT ; idx++ )
+		{
+			m_arPhase[ idx ].ulSum >>= 1;
+		}
+
+		m_ulAvgLoops >>= 1;
+	}
+}
+
+
+//**********************************************************************
+//	ReadLNCV
+//----------------------------------------------------------------------
+//	delivers the value of the read-only profile LNCV 'uiLncv'
+//	(times in us). Returns false if 'uiLncv' is not a profile LNCV.
+//
+bool LoopProfilerClass::ReadLNCV( uint16_t uiLncv, uint16_t *puiValue )
+{
+	profile_phase_t *	pPhase;
+	uint32_t			ulCount;
+
+	if( (LNCV_ADR_FIRST_PROFILE > uiLncv) || (LNCV_ADR_LAST_PROFILE < uiLncv) )
+	{
+		return( false );
+	}
+
+	if( LNCV_ADR_FIRST_HISTOGRAM <= uiLncv )
+	{
+		ulCount		= m_arulHistogram[ uiLncv - LNCV_ADR_FIRST_HISTOGRAM ];
+		*puiValue	= (0xFFFF < ulCount) ? 0xFFFF : (uint16_t)ulCount;
+	}
+	else if( LNCV_ADR_PROFILE_LOOPS_LOW == uiLncv )
+	{
+		*puiValue = (uint16_t)m_ulLoops;
+	}
+	else if( LNCV_ADR_PROFILE_LOOPS_HIGH == uiLncv )
+	{
+		*puiValue = (uint16_t)(m_ulLoops >> 16);
+	}
+	else if( (LNCV_ADR_FIRST_PROFILE + (PROFILE_PHASE_COUNT * 3)) > uiLncv )
+	{
+		uiLncv -= LNCV_ADR_FIRST_PROFILE;
+		pPhase	= &m_arPhase[ uiLncv / 3 ];
+
+		if( 0 == m_ulAvgLoops )
+		{
+			*puiValue = 0;
+		}
+		else
+		{
+			switch( uiLncv % 3 )
+			{
+				case 0:		*puiValue = CountsToMicros( pPhase->uiMin );				break;
+				case 1:		*puiValue = CountsToMicros( pPhase->ulSum / m_ulAvgLoops );	break;
+				default:	*puiValue = CountsToMicros( pPhase->uiMax );				break;
+			}
+		}
+	}
+	else
+	{
+		return( false );
+	}
+
+	return( true );
+}
+
+
+//**************************************************************************
+//**************************************************************************
+#endif	//	LOOP_PROFILING
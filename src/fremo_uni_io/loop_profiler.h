@@ -0,0 +1,162 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		LoopProfilerClass
+//#
+//#	This class measures the time of each phase of 'loop()' with
+//#	Timer 3 (see cycle_counter.h, 4 us per count):
+//#		PROFILE_PHASE_MESSAGE	CheckForMessage()
+//#		PROFILE_PHASE_LN_STATE	CheckLeds(), CheckLnState()
+//#		PROFILE_PHASE_IO_STATE	changed inputs, CheckIOState(),
+//#								CheckOffDelays()
+//#		PROFILE_PHASE_SEND		ProcessSendQueue()
+//#		PROFILE_PHASE_PROG		programming mode
+//#		PROFILE_PHASE_STATUS	PrintStatus()
+//#	For each phase min, avg and max are kept, for the whole loop
+//#	a histogram with PROFILE_HIST_COUNT classes:
+//#		< 64 us, < 128 us, < 256 us, ... < 4 ms, >= 4 ms
+//#	The results are read by the LNCV programmer as read-only
+//#	LNCVs (see lncv_storage.h).
+//#
+//#	Only compiled with the compile option LOOP_PROFILING, otherwise
+//#	the macros PROFILE_START() and PROFILE_PHASE() are empty.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Bugfix:
+//#		-	the sums for the average overflowed after some hours,
+//#			now they are halved together with their number of
+//#			loops before they can overflow
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include "compile_options.h"
+
+#include <stdint.h>
+
+
+#ifdef LOOP_PROFILING
+//**************************************************************************
+//**************************************************************************
+
+
+#include "cycle_counter.h"
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+#define PROFILE_PHASE_MESSAGE		0
+#define PROFILE_PHASE_LN_STATE		1
+#define PROFILE_PHASE_IO_STATE		2
+#define PROFILE_PHASE_SEND			3
+#define PROFILE_PHASE_PROG			4
+#define PROFILE_PHASE_STATUS		5
+#define PROFILE_PHASE_COUNT			6
+
+//----------------------------------------------------------------------
+//	histogram of the loop time
+//	class 0 up to PROFILE_HIST_FIRST counts, each further class
+//	doubles the time, the last class takes all longer loops
+//
+#define PROFILE_HIST_COUNT			8
+#define PROFILE_HIST_FIRST_SHIFT	4		//	16 counts = 64 us
+
+//----------------------------------------------------------------------
+//	a phase adds at most 0xFFFF counts per loop, so the sums can't
+//	overflow within PROFILE_AVG_LOOPS loops. Then all sums and the
+//	number of loops for the average are halved.
+//
+#define PROFILE_AVG_LOOPS			0x00010000UL
+
+#define PROFILE_START()				g_clLoopProfiler.Start()
+#define PROFILE_PHASE( phase )		g_clLoopProfiler.Phase( phase )
+
+
+typedef struct profile_phase
+{
+	uint16_t	uiMin;
+	uint16_t	uiMax;
+	uint32_t	ulSum;
+
+}	profile_phase_t;
+
+
+//==========================================================================
+//
+//		C L A S S   D E F I N I T I O N S
+//
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////
+//	CLASS:	LoopProfilerClass
+//
+class LoopProfilerClass
+{
+	public:
+		LoopProfilerClass();
+
+		void Init( void );
+		void Phase( uint8_t usPhase );
+		bool ReadLNCV( uint16_t uiLncv, uint16_t *puiValue );
+
+		inline void Start( void )
+		{
+			m_uiLast	= CycleCounterRead();
+			m_uiStart	= m_uiLast;
+		};
+
+	private:
+		//----------------------------------------------------------
+		//	m_uiStart		timer at the start of the loop
+		//	m_uiLast		timer at the end of the last phase
+		//	m_ulLoops		number of loops measured
+		//	m_ulAvgLoops	number of loops in the sums of the phases
+		//
+		uint16_t			m_uiStart;
+		uint16_t			m_uiLast;
+		uint32_t			m_ulLoops;
+		uint32_t			m_ulAvgLoops;
+		profile_phase_t		m_arPhase[ PROFILE_PHASE_COUNT ];
+		uint32_t			m_arulHistogram[ PROFILE_HIST_COUNT ];
+};
+
+
+//==========================================================================
+//
+//		E X T E R N   G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+extern LoopProfilerClass	g_clLoopProfiler;
+
+
+//**************************************************************************
+//**************************************************************************
+#else	//	LOOP_PROFILING
+
+#define PROFILE_START()
+#define PROFILE_PHASE( phase )
+
+#endif	//	LOOP_PROFILING
@@ -7,6 +7,118 @@
 //#
 //#-------------------------------------------------------------------------
 //#
+//#	File version:	13		vom: 17.10.2026
+//#
+//#	Bugfix:
+//#		-	ForgetReports() took a new entry for an address that
+//#			was not in the report table and left a free entry
+//#			behind, the next report then evicted the entry of
+//#			another address. ForgetReports() only clears an
+//#			existing entry now, FindReport() takes the entry of
+//#			the address or a free entry before it evicts one.
+//#			new function
+//#				LookupReport()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	12		vom: 17.10.2026
+//#
+//#	Bugfix:
+//#		-	the report window did never suppress a report: the
+//#			last report was kept per input, but the reports of
+//#			one input always change the direction. Now the last
+//#			report is kept per address and message type, so the
+//#			same report of another input using the address is
+//#			suppressed.
+//#			new function
+//#				FindReport()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	11		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	BENCHMARK_HOT_PATH: in a dry run 'ProcessSendQueue()'
+//#			drops the next message instead of sending it
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	10		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	received and sent messages and the LNCV programming
+//#			are traced (compile option USB_TRACE)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	9		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	the LNCVs of the loop profiler are read-only counters too
+//#			(compile option LOOP_PROFILING)
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	8		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	runtime counters (packets received and for our outputs,
+//#			messages sent and failed, max loop time, ...)
+//#			they are served as read-only LNCVs by 'notifyLNCVread()',
+//#			writing them is answered with LNCV_LACK_ERROR_READONLY
+//#		-	the result of the send functions is checked, only a
+//#			message that was sent is kept in the echo table
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	7		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	a report of an input with the same address and direction
+//#			as its last report is not sent again within the report
+//#			window (LNCV 6)
+//#		-	each message sent is kept in an echo table, its echo
+//#			from the bus is dropped at the start of
+//#			'LoconetReceived()'. Our own outputs using the address
+//#			are set when the message is sent.
+//#			new functions
+//#				ForgetReports()
+//#				MessageSent()
+//#				IsEcho()
+//#				SetOutputs()	(second part of 'LoconetReceived()')
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	6		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	use the address index of the LNCV storage in function
+//#			'LoconetReceived()' instead of checking all I/O pins
+//#
+//#	Bugfix:
+//#		-	if more than one output used the same address, an inverted
+//#			output also inverted 'dir' for all following outputs
+//#			this bug is fixed now
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	5		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add send queue
+//#			'SendMessage()' will no longer wait for the send delay time
+//#			but stores the message in a queue.
+//#			'ProcessSendQueue()' sends the next message as soon as the
+//#			send delay time since the last message is over.
+//#			Sensor messages will be sent before switch messages, but
+//#			the release of a switch request is always sent next.
+//#			new functions
+//#				ProcessSendQueue()
+//#				PushMessage()
+//#				PopMessage()
+//#
+//#-------------------------------------------------------------------------
+//#
 //#	File version:	4		vom: 04.02.2023
 //#
 //#	Implementation:
@@ -61,8 +173,11 @@
 #include "debugging.h"
 #endif
 
+#include "boot_phases.h"
 #include "lncv_storage.h"
+#include "loop_profiler.h"
 #include "my_loconet.h"
+#include "usb_trace.h"
 
 
 //==========================================================================
@@ -73,6 +188,9 @@
 
 #define LOCONET_TX_PIN			7
 
+static_assert(	(LNCV_ADR_FIRST_BOOT_TIME + BOOT_PHASE_COUNT - 1) == LNCV_ADR_LAST_COUNTER,
+				"the boot times do not fit into the counter LNCVs"	);
+
 
 //==========================================================================
 //
@@ -103,8 +221,43 @@ lnMsg			*g_pLnPacket;
 //
 MyLoconetClass::MyLoconetClass()
 {
-	m_uiInputStatus	= 0x0000;
-	m_bIsProgMode	= false;
+	m_uiInputStatus			= 0x0000;
+	m_bIsProgMode			= false;
+
+#ifdef BENCHMARK_HOT_PATH
+	m_bDryRun				= false;
+#endif
+
+	m_SensorQueue.usRead	= 0;
+	m_SensorQueue.usCount	= 0;
+	m_SwitchQueue.usRead	= 0;
+	m_SwitchQueue.usCount	= 0;
+	m_usSendQueueMax		= 0;
+	m_ulLastSendTime		= 0L;
+	m_usEchoWrite			= 0;
+	m_uiSuppressedReports	= 0;
+	m_uiSuppressedEchoes	= 0;
+	m_uiRxPackets			= 0;
+	m_uiRxMatched			= 0;
+	m_uiTxMessages			= 0;
+	m_uiTxFailed			= 0;
+	m_uiLoopTimeMax			= 0;
+
+	m_usReportWrite			= 0;
+
+	for( uint8_t idx = 0 ; idx < REPORT_TABLE_SIZE ; idx++ )
+	{
+		m_arLastReport[ idx ].ulTime	= 0L;
+		m_arLastReport[ idx ].uiKey		= 0;
+		m_arLastReport[ idx ].usDir		= REPORT_DIR_NONE;
+	}
+
+	for( uint8_t idx = 0 ; idx < ECHO_TABLE_SIZE ; idx++ )
+	{
+		m_arEcho[ idx ].uiKey	= 0;
+		m_arEcho[ idx ].uiTime	= 0;
+		m_arEcho[ idx ].usDir	= 0;
+	}
 }
 
 
@@ -128,6 +281,8 @@ void MyLoconetClass::CheckForMessage( void )
 
 	if( g_pLnPacket )
 	{
+		m_uiRxPackets++;
+
 		if( !LocoNet.processSwitchSensorMessage( g_pLnPacket ) )
 		{
 			g_clLNCV.processLNCVMessage( g_pLnPacket );
@@ -140,101 +295,304 @@ void MyLoconetClass::CheckForMessage( void )
 //	LoconetReceived
 //------------------------------------------------------------------
 //	This function checks if the received message is for 'us'.
-//	This is done by checking whether the address of the message
-//	matches one of the stored addresses.
-//	If so, the corresponding bit of the 'InputState' will be set
-//	according to the info in the message.
+//	The echo of a message that we have sent is dropped at once,
+//	our outputs were already set when it was sent.
 //
 void MyLoconetClass::LoconetReceived(	bool isSensor,
 										uint16_t adr,
 										uint8_t dir,
 										uint8_t			)
 {
-	uint16_t	asOutputs	= g_clLncvStorage.GetAsOutputs();
-	uint16_t	asSensor	= g_clLncvStorage.GetAsSensor();
-	uint16_t	isInverse	= g_clLncvStorage.GetIsInverse();
-	uint16_t	ioAddress	= 0;
-	uint16_t	mask		= 0x0001;
+	bool	bMatched;
 
-	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
+	if( IsEcho( isSensor, adr, dir ) )
+	{
+		m_uiSuppressedEchoes++;
+
+		TRACE_LN_RX( adr, TRACE_LN_FLAGS( isSensor, dir ) | TRACE_FLAG_ECHO );
+
+		return;
+	}
+
+	bMatched = SetOutputs( isSensor, adr, dir );
+
+	if( bMatched )
+	{
+		m_uiRxMatched++;
+	}
+
+	TRACE_LN_RX( adr, TRACE_LN_FLAGS( isSensor, dir ) | (bMatched ? TRACE_FLAG_MATCHED : 0) );
+}
+
+
+//******************************************************************
+//	SetOutputs
+//------------------------------------------------------------------
+//	The address index of the LNCV storage delivers all outputs
+//	that use the address of the message.
+//	If there are any, the corresponding bits of the 'InputState'
+//	will be set according to the info in the message.
+//	Returns false if none of our outputs uses the address.
+//
+bool MyLoconetClass::SetOutputs( bool isSensor, uint16_t adr, uint8_t dir )
+{
+	uint16_t	uiInverse	= 0x0000;
+	uint16_t	uiPinMask	= g_clLncvStorage.FindOutputAddress(	isSensor, adr,
+																	&uiInverse		);
+
+	if( 0x0000 == uiPinMask )
 	{
 		//----------------------------------------------------------
-		//	first check if the pin 'idx' is an output
-		//	if so, process the message
+		//	none of our addresses
 		//
-		if( asOutputs & mask )
-		{
-			//------------------------------------------------------
-			//	second check if we are searching for an address in
-			//	a sensor message or in a switch message.
-			//
-			//	isSensor == false	we are looking for switch messages
-			//	isSensor == true	we are looking for sensor messages
-			//
-			//	'asSensor' will hold the info if the message at the
-			//	actual bit position (mask) is expected to be
-			//	a sensor message or a switch message.
-			//	(bit set => sensor message)
-			//
-			if( isSensor == (0 != (asSensor & mask)) )
-			{
-				ioAddress = g_clLncvStorage.GetIOAddress( idx );
-
-				if(	(0 < ioAddress) && (adr == ioAddress) )
-				{
-					//----------------------------------------------
-					//	This is one of our addresses, ergo go on
-					//	with the processing
-					//
-
-					//----------------------------------------------
-					//	Check if 'dir' should be inverted
-					//
-					if( isInverse & mask )
-					{
-						if( 0 == dir )
-						{
-							dir = 1;
-						}
-						else
-						{
-							dir = 0;
-						}
-					}
-
-					//----------------------------------------------
-					//	store direction 'dir' in the input status
-					//
-					if(	dir )
-					{
-						m_uiInputStatus |= mask;
-					}
-					else
-					{
-						m_uiInputStatus &= ~mask;
-					}
+		return( false );
+	}
+
+	//--------------------------------------------------------------
+	//	store direction 'dir' in the input status of all pins
+	//	using this address, inverted where necessary
+	//
+	m_uiInputStatus &= ~uiPinMask;
+	m_uiInputStatus |= ((dir ? uiPinMask : 0x0000) ^ uiInverse);
 
 #ifdef DEBUGGING_PRINTOUT
-//					g_clDebugging.PrintNotifyMsg( adr, dir );
-					g_clDebugging.PrintNotifyMsg( idx, dir );
+	uint16_t	mask = 0x0001;
+
+	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
+	{
+		if( uiPinMask & mask )
+		{
+			g_clDebugging.PrintNotifyMsg( idx, (m_uiInputStatus & mask) ? 1 : 0 );
+		}
+
+		mask <<= 1;
+	}
 #endif
-				}
 
-			}	//	if( isSensor == (0 != (asSensor & mask)) )
+	return( true );
+}
 
-		}	//	if( mask & asInputs )
 
-		mask <<= 1;
+//**********************************************************************
+//	IsEcho
+//----------------------------------------------------------------------
+//	returns true if the message was sent by us within the last
+//	ECHO_TIMEOUT ms. The entry in the echo table is removed, so
+//	each message sent is recognized only once.
+//
+bool MyLoconetClass::IsEcho( bool isSensor, uint16_t uiAddress, uint8_t usDir )
+{
+	uint16_t	uiKey	= (uiAddress << 1) | (isSensor ? 0x0001 : 0x0000);
+	uint16_t	uiNow	= (uint16_t)millis();
+
+	usDir = usDir ? 1 : 0;
+
+	for( uint8_t idx = 0 ; idx < ECHO_TABLE_SIZE ; idx++ )
+	{
+		if(		(uiKey == m_arEcho[ idx ].uiKey)
+			&&	(usDir == m_arEcho[ idx ].usDir)
+			&&	(ECHO_TIMEOUT > (uint16_t)(uiNow - m_arEcho[ idx ].uiTime))	)
+		{
+			m_arEcho[ idx ].uiKey = 0;
+
+			return( true );
+		}
+	}
+
+	return( false );
+}
+
+
+//**********************************************************************
+//	MessageSent
+//----------------------------------------------------------------------
+//	If the message was sent to the bus, it is kept in the echo table
+//	and our own outputs using the address are set at once.
+//	'status' is the result of the LocoNet send function.
+//
+void MyLoconetClass::MessageSent( LN_STATUS status, bool isSensor, uint16_t uiAddress, uint8_t usDir )
+{
+	echo_entry_t *	pEcho	= &m_arEcho[ m_usEchoWrite ];
+
+	if( LN_DONE != status )
+	{
+		m_uiTxFailed++;
+
+		TRACE_LN_TX( uiAddress, TRACE_LN_FLAGS( isSensor, usDir ) | TRACE_FLAG_FAILED );
+
+		return;
+	}
+
+	TRACE_LN_TX( uiAddress, TRACE_LN_FLAGS( isSensor, usDir ) );
+
+	m_uiTxMessages++;
+
+	m_usEchoWrite = (m_usEchoWrite + 1) & (ECHO_TABLE_SIZE - 1);
+
+	pEcho->uiKey	= (uiAddress << 1) | (isSensor ? 0x0001 : 0x0000);
+	pEcho->uiTime	= (uint16_t)millis();
+	pEcho->usDir	= usDir ? 1 : 0;
+
+	SetOutputs( isSensor, uiAddress, usDir );
+}
+
+
+//**********************************************************************
+//	ForgetReports
+//----------------------------------------------------------------------
+//	The next report of the inputs in 'uiMask' will be sent in any
+//	case (e.g. after a change of the configuration).
+//	The addresses of the inputs must already be the new ones.
+//
+void MyLoconetClass::ForgetReports( uint16_t uiMask )
+{
+	report_entry_t *	pReport;
+	uint16_t			uiSensor	= g_clLncvStorage.GetAsSensor();
+	uint16_t			uiKey;
+
+	for( uint8_t idx = 0 ; idx < IO_NUMBERS ; idx++ )
+	{
+		if( uiMask & 0x0001 )
+		{
+			uiKey	= (g_clLncvStorage.GetIOAddress( idx ) << 1) | (uiSensor & 0x0001);
+			pReport	= LookupReport( uiKey );
+
+			if( NULL != pReport )
+			{
+				pReport->usDir = REPORT_DIR_NONE;
+			}
+		}
+
+		uiMask		>>= 1;
+		uiSensor	>>= 1;
+	}
+}
+
+
+//**********************************************************************
+//	LookupReport
+//----------------------------------------------------------------------
+//	returns the entry of the report table for 'uiKey' or NULL if
+//	the key is not in the table
+//
+report_entry_t *MyLoconetClass::LookupReport( uint16_t uiKey )
+{
+	for( uint8_t idx = 0 ; idx < REPORT_TABLE_SIZE ; idx++ )
+	{
+		if(		(uiKey == m_arLastReport[ idx ].uiKey)
+			&&	(REPORT_DIR_NONE != m_arLastReport[ idx ].usDir)	)
+		{
+			return( &m_arLastReport[ idx ] );
+		}
+	}
+
+	return( NULL );
+}
+
+
+//**********************************************************************
+//	FindReport
+//----------------------------------------------------------------------
+//	returns the entry of the report table for 'uiKey'.
+//	If the key is not in the table, a free entry is given to the
+//	key. Only if there is no free entry, the next entry in turn is
+//	cleared and given to the key.
+//
+report_entry_t *MyLoconetClass::FindReport( uint16_t uiKey )
+{
+	report_entry_t *	pReport	= LookupReport( uiKey );
+
+	if( NULL != pReport )
+	{
+		return( pReport );
+	}
+
+	for( uint8_t idx = 0 ; idx < REPORT_TABLE_SIZE ; idx++ )
+	{
+		if( REPORT_DIR_NONE == m_arLastReport[ idx ].usDir )
+		{
+			pReport = &m_arLastReport[ idx ];
+			break;
+		}
+	}
+
+	if( NULL == pReport )
+	{
+		pReport			= &m_arLastReport[ m_usReportWrite ];
+		m_usReportWrite	= (m_usReportWrite + 1) % REPORT_TABLE_SIZE;
+	}
+
+	pReport->uiKey	= uiKey;
+	pReport->usDir	= REPORT_DIR_NONE;
+
+	return( pReport );
+}
+
+
+//**********************************************************************
+//	ReadCounter
+//----------------------------------------------------------------------
+//	delivers the runtime counter of the read-only LNCV 'uiLncv'.
+//	Returns false if 'uiLncv' is not a counter.
+//
+bool MyLoconetClass::ReadCounter( uint16_t uiLncv, uint16_t *puiValue )
+{
+	uint32_t	ulUptime	= millis() / 1000;
+
+	switch( uiLncv )
+	{
+		case LNCV_ADR_RX_PACKETS:			*puiValue = m_uiRxPackets;				break;
+		case LNCV_ADR_RX_MATCHED:			*puiValue = m_uiRxMatched;				break;
+		case LNCV_ADR_TX_MESSAGES:			*puiValue = m_uiTxMessages;				break;
+		case LNCV_ADR_TX_FAILED:			*puiValue = m_uiTxFailed;				break;
+		case LNCV_ADR_SEND_QUEUE_COUNT:		*puiValue = GetSendQueueCount();		break;
+		case LNCV_ADR_SEND_QUEUE_MAX:		*puiValue = m_usSendQueueMax;			break;
+		case LNCV_ADR_SUPPRESSED_REPORTS:	*puiValue = m_uiSuppressedReports;		break;
+		case LNCV_ADR_SUPPRESSED_ECHOES:	*puiValue = m_uiSuppressedEchoes;		break;
+		case LNCV_ADR_UPTIME_LOW:			*puiValue = (uint16_t)ulUptime;			break;
+		case LNCV_ADR_UPTIME_HIGH:			*puiValue = (uint16_t)(ulUptime >> 16);	break;
+		case LNCV_ADR_LOOP_TIME_MAX:		*puiValue = m_uiLoopTimeMax;			break;
+
+		default:
+			if(		(LNCV_ADR_FIRST_BOOT_TIME <= uiLncv)
+				&&	((LNCV_ADR_FIRST_BOOT_TIME + BOOT_PHASE_COUNT) > uiLncv)	)
+			{
+				*puiValue = g_aruiBootTime[ uiLncv - LNCV_ADR_FIRST_BOOT_TIME ];
+				break;
+			}
+
+#ifdef LOOP_PROFILING
+			if( g_clLoopProfiler.ReadLNCV( uiLncv, puiValue ) )
+			{
+				break;
+			}
+#endif
+
+			return( false );
 	}
+
+	return( true );
 }
 
 
 //**********************************************************************
 //	SendMessage
 //----------------------------------------------------------------------
+//	The message will not be sent directly but stored in the
+//	send queue. So the function will return at once.
+//	The queue is handled by 'ProcessSendQueue()'.
+//	If the same report (address, message type and direction) was
+//	sent within the report window, e.g. by another input using the
+//	same address, the message is suppressed.
 //
 void MyLoconetClass::SendMessage( uint16_t adr, uint16_t mask, uint8_t dir )
 {
+	send_queue_t *		pQueue;
+	report_entry_t *	pReport;
+	uint32_t			ulNow;
+	bool				isSensor;
+	uint8_t				usFlags	= 0;
+
 	//--------------------------------------------------------------
 	//	send the message only if there is an address for it
 	//
@@ -255,41 +613,182 @@ void MyLoconetClass::SendMessage( uint16_t adr, uint16_t mask, uint8_t dir )
 			}
 		}
 
+		if( dir )
+		{
+			usFlags |= SEND_FLAG_DIR;
+		}
+
+		isSensor = (0 != (g_clLncvStorage.GetAsSensor() & mask));
+
+		//----------------------------------------------------------
+		//	Check if the same report was sent
+		//	within the report window
+		//
+		pReport	= FindReport( (adr << 1) | (isSensor ? 0x0001 : 0x0000) );
+		ulNow	= millis();
+
+		if(		(dir == pReport->usDir)
+			&&	(g_clLncvStorage.GetReportWindow() > (ulNow - pReport->ulTime))	)
+		{
+			m_uiSuppressedReports++;
+
+			return;
+		}
+
+		pReport->ulTime	= ulNow;
+		pReport->usDir	= dir;
+
 		//----------------------------------------------------------
 		//	Check if this should be a sensor or
 		//	a switch message
 		//
-		if( g_clLncvStorage.GetAsSensor() & mask )
+		if( isSensor )
 		{
-			//----	sensor message  --------------------------------
-			//
-			LocoNet.reportSensor( adr, dir );
-
-#ifdef DEBUGGING_PRINTOUT
-//			g_clDebugging.PrintReportSensorMsg( adr, dir );
-#endif
+			pQueue = &m_SensorQueue;
 		}
 		else
 		{
-			//----	switch message  --------------------------------
-			//
-			LocoNet.requestSwitch( adr, 1, dir );
+			pQueue = &m_SwitchQueue;
+		}
 
-#ifdef DEBUGGING_PRINTOUT
-//			g_clDebugging.PrintReportSwitchMsg( adr, dir );
+		//----------------------------------------------------------
+		//	if the queue is full, there is no other way than
+		//	to wait until the next message was sent
+		//
+		while( !PushMessage( pQueue, adr, usFlags ) )
+		{
+			ProcessSendQueue();
+		}
+
+		if( GetSendQueueCount() > m_usSendQueueMax )
+		{
+			m_usSendQueueMax = GetSendQueueCount();
+		}
+	}
+}
+
+
+//**********************************************************************
+//	ProcessSendQueue
+//----------------------------------------------------------------------
+//	This function should be called in every loop.
+//	If the send delay time since the last message is over, the
+//	next message will be sent. The order is:
+//		-	release of a switch request that was already sent
+//		-	sensor messages
+//		-	switch requests
+//
+void MyLoconetClass::ProcessSendQueue( void )
+{
+	send_entry_t *	pEntry;
+	LN_STATUS		status;
+
+	if( (0 == m_SensorQueue.usCount) && (0 == m_SwitchQueue.usCount) )
+	{
+		return;
+	}
+
+#ifdef BENCHMARK_HOT_PATH
+	//--------------------------------------------------------------
+	//	dry run of the benchmark: nothing goes to the Loconet
+	//
+	if( m_bDryRun )
+	{
+		PopMessage( (0 < m_SensorQueue.usCount) ? &m_SensorQueue : &m_SwitchQueue );
+
+		return;
+	}
 #endif
 
-			//----	wait befor sending the next message  -----------
-			//
-			delay( g_clLncvStorage.GetSendDelayTime() );
+	//--------------------------------------------------------------
+	//	wait befor sending the next message
+	//
+	if( (millis() - m_ulLastSendTime) < g_clLncvStorage.GetSendDelayTime() )
+	{
+		return;
+	}
+
+	pEntry = &m_SwitchQueue.arEntry[ m_SwitchQueue.usRead ];
 
-			LocoNet.requestSwitch( adr, 0, dir );
-		}
+	if( (0 < m_SwitchQueue.usCount) && (pEntry->usFlags & SEND_FLAG_RELEASE) )
+	{
+		//----	release of switch message  -------------------------
+		//
+		status = LocoNet.requestSwitch( pEntry->uiAddress, 0, pEntry->usFlags & SEND_FLAG_DIR );
+
+		MessageSent( status, false, pEntry->uiAddress, pEntry->usFlags & SEND_FLAG_DIR );
 
-		//----	wait befor sending the next message  ---------------
+		PopMessage( &m_SwitchQueue );
+	}
+	else if( 0 < m_SensorQueue.usCount )
+	{
+		//----	sensor message  ------------------------------------
 		//
-		delay( g_clLncvStorage.GetSendDelayTime() );
+		pEntry = &m_SensorQueue.arEntry[ m_SensorQueue.usRead ];
+
+		status = LocoNet.reportSensor( pEntry->uiAddress, pEntry->usFlags & SEND_FLAG_DIR );
+
+		MessageSent( status, true, pEntry->uiAddress, pEntry->usFlags & SEND_FLAG_DIR );
+
+#ifdef DEBUGGING_PRINTOUT
+//		g_clDebugging.PrintReportSensorMsg( pEntry->uiAddress, pEntry->usFlags & SEND_FLAG_DIR );
+#endif
+
+		PopMessage( &m_SensorQueue );
 	}
+	else
+	{
+		//----	switch message  ------------------------------------
+		//	the entry stays in the queue until the release
+		//	was sent too
+		//
+		status = LocoNet.requestSwitch( pEntry->uiAddress, 1, pEntry->usFlags & SEND_FLAG_DIR );
+
+		MessageSent( status, false, pEntry->uiAddress, pEntry->usFlags & SEND_FLAG_DIR );
+
+#ifdef DEBUGGING_PRINTOUT
+//		g_clDebugging.PrintReportSwitchMsg( pEntry->uiAddress, pEntry->usFlags & SEND_FLAG_DIR );
+#endif
+
+		pEntry->usFlags |= SEND_FLAG_RELEASE;
+	}
+
+	m_ulLastSendTime = millis();
+}
+
+
+//**********************************************************************
+//	PushMessage
+//----------------------------------------------------------------------
+//	returns false if the queue is full
+//
+bool MyLoconetClass::PushMessage( send_queue_t *pQueue, uint16_t uiAddress, uint8_t usFlags )
+{
+	uint8_t	usWrite;
+
+	if( SEND_QUEUE_SIZE <= pQueue->usCount )
+	{
+		return( false );
+	}
+
+	usWrite = (pQueue->usRead + pQueue->usCount) % SEND_QUEUE_SIZE;
+
+	pQueue->arEntry[ usWrite ].uiAddress	= uiAddress;
+	pQueue->arEntry[ usWrite ].usFlags		= usFlags;
+	pQueue->usCount++;
+
+	return( true );
+}
+
+
+//**********************************************************************
+//	PopMessage
+//----------------------------------------------------------------------
+//
+void MyLoconetClass::PopMessage( send_queue_t *pQueue )
+{
+	pQueue->usRead = (pQueue->usRead + 1) % SEND_QUEUE_SIZE;
+	pQueue->usCount--;
 }
 
 
@@ -365,6 +864,8 @@ int8_t notifyLNCVdiscover( uint16_t &ArtNr, uint16_t &ModuleAddress )
 	g_clDebugging.PrintLncvDiscoverStart( false, ArtNr, ModuleAddress  );
 #endif
 
+	TRACE_LNCV( TRACE_TYPE_LNCV_START, ArtNr, ModuleAddress );
+
 	return( LNCV_LACK_OK );
 }
 
@@ -400,6 +901,8 @@ int8_t notifyLNCVprogrammingStart( uint16_t &ArtNr, uint16_t &ModuleAddress )
 	g_clDebugging.PrintLncvDiscoverStart( true, ArtNr, ModuleAddress  );
 #endif
 
+	TRACE_LNCV( TRACE_TYPE_LNCV_START, ArtNr, ModuleAddress );
+
 	return( retval );
 }
 
@@ -414,6 +917,8 @@ void notifyLNCVprogrammingStop( uint16_t ArtNr, uint16_t ModuleAddress )
 	g_clDebugging.PrintLncvStop();
 #endif
 
+	TRACE_LNCV( TRACE_TYPE_LNCV_STOP, ArtNr, ModuleAddress );
+
 	if( g_clMyLoconet.IsProgMode() )
 	{
 		if( 	(g_clLncvStorage.GetArticleNumber() == ArtNr)
@@ -441,6 +946,10 @@ int8_t notifyLNCVread( uint16_t ArtNr, uint16_t Address, uint16_t, uint16_t &Val
 			Value	= g_clLncvStorage.ReadLNCV( Address );
 			retval	= LNCV_LACK_OK;
 		}
+		else if( g_clMyLoconet.ReadCounter( Address, &Value ) )
+		{
+			retval	= LNCV_LACK_OK;
+		}
 		else
 		{
 			retval = LNCV_LACK_ERROR_UNSUPPORTED;
@@ -451,6 +960,8 @@ int8_t notifyLNCVread( uint16_t ArtNr, uint16_t Address, uint16_t, uint16_t &Val
 	g_clDebugging.PrintLncvReadWrite( true, Address, Value );
 #endif
 
+	TRACE_LNCV( TRACE_TYPE_LNCV_READ, Address, Value );
+
 	return( retval );
 }
 
@@ -461,7 +972,8 @@ int8_t notifyLNCVread( uint16_t ArtNr, uint16_t Address, uint16_t, uint16_t &Val
 //
 int8_t notifyLNCVwrite( uint16_t ArtNr, uint16_t Address, uint16_t Value )
 {
-	int8_t retval = -1;		//	default: ignore request
+	uint16_t	uiCounter;
+	int8_t		retval = -1;		//	default: ignore request
 
 	if( g_clMyLoconet.IsProgMode() && (g_clLncvStorage.GetArticleNumber() == ArtNr) )
 	{
@@ -475,6 +987,10 @@ int8_t notifyLNCVwrite( uint16_t ArtNr, uint16_t Address, uint16_t Value )
 
 			retval = LNCV_LACK_OK;
 		}
+		else if( g_clMyLoconet.ReadCounter( Address, &uiCounter ) )
+		{
+			retval = LNCV_LACK_ERROR_READONLY;
+		}
 		else
 		{
 			retval = LNCV_LACK_ERROR_UNSUPPORTED;
@@ -485,5 +1001,7 @@ int8_t notifyLNCVwrite( uint16_t ArtNr, uint16_t Address, uint16_t Value )
 	g_clDebugging.PrintLncvReadWrite( false, Address, Value );
 #endif
 
+	TRACE_LNCV( TRACE_TYPE_LNCV_WRITE, Address, Value );
+
 	return( retval );
 }
@@ -9,6 +9,76 @@
 //#
 //#-------------------------------------------------------------------------
 //#
+//#	File version:	8		vom: 17.10.2026
+//#
+//#	Bugfix:
+//#		-	new function LookupReport()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	7		vom: 17.10.2026
+//#
+//#	Bugfix:
+//#		-	the last reports are kept per address and message type
+//#			instead of per input. The reports of one input always
+//#			change the direction, so only the report of another
+//#			input with the same address can be a duplicate.
+//#			new function FindReport()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	6		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	BENCHMARK_HOT_PATH: dry run, the send queue is emptied
+//#			without sending to the Loconet
+//#			new function SetDryRun()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	5		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	runtime counters, read by the LNCV programmer
+//#			(read-only LNCVs, see lncv_storage.h)
+//#			new functions
+//#				ReadCounter()
+//#				SetLoopTime()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	4		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	suppression of duplicate reports and of the echoes of
+//#			our own messages
+//#			new functions
+//#				ForgetReports()
+//#				GetSuppressedReports()
+//#				GetSuppressedEchoes()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	3		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new function SetInputStatus()
+//#			to restore the state of the outputs at startup
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	add send queue
+//#			messages are no longer sent directly but stored in a queue
+//#			new functions
+//#				ProcessSendQueue()
+//#				GetSendQueueCount()
+//#				GetSendQueueMax()
+//#
+//#-------------------------------------------------------------------------
+//#
 //#	File version:	1		vom: 14.02.2022
 //#
 //#	Implementation:
@@ -23,7 +93,96 @@
 //
 //==========================================================================
 
+#include "compile_options.h"
+
 #include <stdint.h>
+#include <LocoNet.h>
+
+#include "lncv_storage.h"
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+//----------------------------------------------------------------------
+//	size of each send queue
+//	at power up every input will send a message, so there must be
+//	space for at least IO_NUMBERS messages
+//
+#define SEND_QUEUE_SIZE		16
+
+
+//----------------------------------------------------------------------
+//	flags of a send queue entry
+//
+#define SEND_FLAG_DIR		0x01	//	direction (after inversion)
+#define SEND_FLAG_RELEASE	0x02	//	switch request sent, release pending
+
+
+typedef struct send_entry
+{
+	uint16_t	uiAddress;
+	uint8_t		usFlags;
+
+}	send_entry_t;
+
+
+typedef struct send_queue
+{
+	send_entry_t	arEntry[ SEND_QUEUE_SIZE ];
+	uint8_t			usRead;
+	uint8_t			usCount;
+
+}	send_queue_t;
+
+
+//----------------------------------------------------------------------
+//	last report of an address
+//	a report with the same address, message type and direction is
+//	not sent again within the report window (LNCV 6), e.g. if
+//	several inputs use the same address.
+//	Each input has one address, so there are never more than
+//	IO_NUMBERS addresses in use. Only after a new configuration
+//	the entries of addresses that are no longer used can fill the
+//	table, then the next entry in turn is evicted.
+//
+//	uiKey		(address << 1) | 1		sensor message
+//				(address << 1) | 0		switch message
+//
+#define REPORT_TABLE_SIZE	IO_NUMBERS
+#define REPORT_DIR_NONE		0xFF
+
+typedef struct report_entry
+{
+	uint32_t	ulTime;
+	uint16_t	uiKey;
+	uint8_t		usDir;
+
+}	report_entry_t;
+
+
+//----------------------------------------------------------------------
+//	echo of our own messages
+//	each message sent is kept in the echo table, until it comes back
+//	from the bus or ECHO_TIMEOUT ms are over (size: power of 2)
+//
+//	uiKey		(address << 1) | 1		sensor message
+//				(address << 1) | 0		switch message
+//				0						free entry
+//
+#define ECHO_TABLE_SIZE		4
+#define ECHO_TIMEOUT		50
+
+typedef struct echo_entry
+{
+	uint16_t	uiKey;
+	uint16_t	uiTime;
+	uint8_t		usDir;
+
+}	echo_entry_t;
 
 
 //==========================================================================
@@ -47,12 +206,48 @@ class MyLoconetClass
 		void CheckForMessage( void );
 		void LoconetReceived( bool isSensor, uint16_t adr, uint8_t dir, uint8_t output );
 		void SendMessage( uint16_t adr, uint16_t mask, uint8_t dir );
+		void ProcessSendQueue( void );
+		void ForgetReports( uint16_t uiMask );
+		bool ReadCounter( uint16_t uiLncv, uint16_t *puiValue );
+
+		inline void SetLoopTime( uint32_t ulTime )
+		{
+			if( ulTime > m_uiLoopTimeMax )
+			{
+				m_uiLoopTimeMax = (0xFFFF < ulTime) ? 0xFFFF : (uint16_t)ulTime;
+			}
+		};
+
+		inline uint16_t GetSuppressedReports( void )
+		{
+			return( m_uiSuppressedReports );
+		};
+
+		inline uint16_t GetSuppressedEchoes( void )
+		{
+			return( m_uiSuppressedEchoes );
+		};
+
+		inline uint8_t GetSendQueueCount( void )
+		{
+			return( m_SensorQueue.usCount + m_SwitchQueue.usCount );
+		};
+
+		inline uint8_t GetSendQueueMax( void )
+		{
+			return( m_usSendQueueMax );
+		};
 
 		inline uint16_t GetInputStatus( void )
 		{
 			return( m_uiInputStatus );
 		}
 
+		inline void SetInputStatus( uint16_t uiStatus )
+		{
+			m_uiInputStatus = uiStatus;
+		}
+
 		inline void SetProgMode( bool bMode )
 		{
 			m_bIsProgMode = bMode;
@@ -63,9 +258,56 @@ class MyLoconetClass
 			return( m_bIsProgMode );
 		};
 
+#ifdef BENCHMARK_HOT_PATH
+		inline void SetDryRun( bool bDryRun )
+		{
+			m_bDryRun = bDryRun;
+		};
+#endif
+
 	private:
-		uint16_t	m_uiInputStatus;
-		bool		m_bIsProgMode;
+		uint16_t		m_uiInputStatus;
+		bool			m_bIsProgMode;
+
+#ifdef BENCHMARK_HOT_PATH
+		bool			m_bDryRun;
+#endif
+
+		//--------------------------------------------------------------
+		//	sensor messages will be sent before switch messages,
+		//	so there is one queue for each message type
+		//
+		send_queue_t	m_SensorQueue;
+		send_queue_t	m_SwitchQueue;
+		uint8_t			m_usSendQueueMax;
+		uint32_t		m_ulLastSendTime;
+
+		//--------------------------------------------------------------
+		//	suppression of duplicate reports and of our echoes
+		//
+		report_entry_t	m_arLastReport[ REPORT_TABLE_SIZE ];
+		uint8_t			m_usReportWrite;
+		echo_entry_t	m_arEcho[ ECHO_TABLE_SIZE ];
+		uint8_t			m_usEchoWrite;
+		uint16_t		m_uiSuppressedReports;
+		uint16_t		m_uiSuppressedEchoes;
+
+		//--------------------------------------------------------------
+		//	runtime counters
+		//
+		uint16_t		m_uiRxPackets;
+		uint16_t		m_uiRxMatched;
+		uint16_t		m_uiTxMessages;
+		uint16_t		m_uiTxFailed;
+		uint16_t		m_uiLoopTimeMax;
+
+		bool			PushMessage( send_queue_t *pQueue, uint16_t uiAddress, uint8_t usFlags );
+		void			PopMessage(  send_queue_t *pQueue );
+		void			MessageSent( LN_STATUS status, bool isSensor, uint16_t uiAddress, uint8_t usDir );
+		bool			IsEcho( bool isSensor, uint16_t uiAddress, uint8_t usDir );
+		report_entry_t *	LookupReport( uint16_t uiKey );
+		report_entry_t *	FindReport( uint16_t uiKey );
+		bool			SetOutputs( bool isSensor, uint16_t uiAddress, uint8_t usDir );
 };
 
 
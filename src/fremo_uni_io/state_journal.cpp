@@ -0,0 +1,257 @@
+//##########################################################################
+//#
+//#		StateJournalClass
+//#
+//#	This class stores the state of the outputs in a journal in the
+//#	EEPROM (see state_journal.h).
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <Arduino.h>
+#include <avr/eeprom.h>
+#include <avr/interrupt.h>
+
+#include "lncv_storage.h"
+#include "state_journal.h"
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+static_assert(	(LNCV_CRC_ADDRESS + 2) <= JOURNAL_START,
+				"the journal overlaps the LNCVs"	);
+
+static_assert(	JOURNAL_SLOTS <= 0xFF,
+				"the slot number does not fit into a byte"	);
+
+
+//==========================================================================
+//
+//		G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+StateJournalClass	g_clStateJournal	= StateJournalClass();
+
+
+//==========================================================================
+//
+//		C L A S S   F U N C T I O N S
+//
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////
+//	CLASS: StateJournalClass
+//
+
+//**********************************************************************
+//	Constructor
+//----------------------------------------------------------------------
+//
+StateJournalClass::StateJournalClass()
+{
+	m_uiWanted		= 0x0000;
+	m_uiStored		= 0x0000;
+	m_uiSequence	= 0;
+	m_usSlot		= 0;
+	m_usEntryByte	= JOURNAL_ENTRY_SIZE;
+}
+
+
+//**********************************************************************
+//	Restore
+//----------------------------------------------------------------------
+//	searches the journal for the last valid entry.
+//	If there is one, the state is returned in 'puiState' and the
+//	next entry will be written behind it.
+//	Returns false if the journal is empty.
+//
+bool StateJournalClass::Restore( uint16_t *puiState )
+{
+	uint16_t	aruiEntry[ JOURNAL_ENTRY_SIZE / 2 ];
+	uint8_t		usLast	= JOURNAL_SLOTS;
+
+	for( uint8_t usSlot = 0 ; usSlot < JOURNAL_SLOTS ; usSlot++ )
+	{
+		eeprom_read_block(	aruiEntry,
+							(const void *)(JOURNAL_START + (usSlot * JOURNAL_ENTRY_SIZE)),
+							JOURNAL_ENTRY_SIZE												);
+
+		if( (aruiEntry[ 0 ] ^ aruiEntry[ 1 ] ^ JOURNAL_CHECK) != aruiEntry[ 2 ] )
+		{
+			//----	empty or not completely written  ----------------
+			continue;
+		}
+
+		//--------------------------------------------------------------
+		//	the sequence number wraps around, so compare by
+		//	subtraction (all entries are less than JOURNAL_SLOTS apart)
+		//
+		if(		(JOURNAL_SLOTS == usLast)
+			||	(0 < (int16_t)(aruiEntry[ 0 ] - m_uiSequence))	)
+		{
+			usLast			= usSlot;
+			m_uiSequence	= aruiEntry[ 0 ];
+			m_uiStored		= aruiEntry[ 1 ];
+		}
+	}
+
+	if( JOURNAL_SLOTS == usLast )
+	{
+		return( false );
+	}
+
+	m_uiWanted	= m_uiStored;
+	m_usSlot	= usLast + 1;
+
+	if( JOURNAL_SLOTS <= m_usSlot )
+	{
+		m_usSlot = 0;
+	}
+
+	*puiState = m_uiStored;
+
+	return( true );
+}
+
+
+//**********************************************************************
+//	Store
+//----------------------------------------------------------------------
+//	The state will be written into the next entry of the journal
+//	by the EEPROM ready interrupt. If the state changes again before
+//	the interrupt starts the entry, only the last state is written.
+//
+void StateJournalClass::Store( uint16_t uiState )
+{
+	uint8_t	usSREG;
+
+	if( uiState == m_uiWanted )
+	{
+		return;
+	}
+
+	usSREG = SREG;
+	cli();
+
+	m_uiWanted	 = uiState;
+	EECR		|= _BV( EERIE );
+
+	SREG = usSREG;
+}
+
+
+//**********************************************************************
+//	WriteNextByte
+//----------------------------------------------------------------------
+//	This function is called by the EEPROM ready interrupt.
+//	It starts the write of the next byte of the entry. If there is
+//	no entry in work and the state has changed, a new entry is
+//	prepared.
+//	Returns false if there is nothing to write.
+//
+//	ATTENTION: only to be called by the interrupt
+//
+bool StateJournalClass::WriteNextByte( void )
+{
+	uint16_t	uiCheck;
+	uint8_t		usByte	= m_usEntryByte;
+
+	if( JOURNAL_ENTRY_SIZE <= usByte )
+	{
+		if( m_uiWanted == m_uiStored )
+		{
+			return( false );
+		}
+
+		m_uiSequence++;
+		m_uiStored	= m_uiWanted;
+		uiCheck		= m_uiSequence ^ m_uiStored ^ JOURNAL_CHECK;
+
+		m_arusEntry[ 0 ]	= (uint8_t)(m_uiSequence & 0xFF);
+		m_arusEntry[ 1 ]	= (uint8_t)(m_uiSequence >> 8);
+		m_arusEntry[ 2 ]	= (uint8_t)(m_uiStored & 0xFF);
+		m_arusEntry[ 3 ]	= (uint8_t)(m_uiStored >> 8);
+		m_arusEntry[ 4 ]	= (uint8_t)(uiCheck & 0xFF);
+		m_arusEntry[ 5 ]	= (uint8_t)(uiCheck >> 8);
+
+		usByte = 0;
+	}
+
+	eeprom_update_byte(	(uint8_t *)(JOURNAL_START + (m_usSlot * JOURNAL_ENTRY_SIZE) + usByte),
+						m_arusEntry[ usByte ]											);
+
+	usByte++;
+
+	//--------------------------------------------------------------
+	//	entry complete, the next one goes into the next slot
+	//
+	if( JOURNAL_ENTRY_SIZE <= usByte )
+	{
+		m_usSlot++;
+
+		if( JOURNAL_SLOTS <= m_usSlot )
+		{
+			m_usSlot = 0;
+		}
+	}
+
+	m_usEntryByte = usByte;
+
+	return( true );
+}
+
+
+//**********************************************************************
+//	IsPending
+//----------------------------------------------------------------------
+//	returns true as long as the last state is not completely
+//	written into the EEPROM
+//
+bool StateJournalClass::IsPending( void )
+{
+	bool	bPending;
+	uint8_t	usSREG	= SREG;
+
+	cli();
+
+	bPending =		(JOURNAL_ENTRY_SIZE > m_usEntryByte)
+				||	(m_uiWanted != m_uiStored)
+				||	!eeprom_is_ready();
+
+	SREG = usSREG;
+
+	return( bPending );
+}
+
+
+//**********************************************************************
+//	Flush
+//----------------------------------------------------------------------
+//	waits until the last state is written into the EEPROM
+//
+void StateJournalClass::Flush( void )
+{
+	while( IsPending() )
+	{
+		delay( 1 );
+	}
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		StateJournalClass
+//#
+//#	This class stores the state of the outputs (the last commanded
+//#	Loconet state) in the EEPROM behind the LNCVs, so the outputs
+//#	can be restored after a power up without any bus traffic.
+//#
+//#	The state is not written to a fixed place but into the next
+//#	entry of a ring (journal). So each change writes other cells
+//#	and the write load is spread over the whole journal.
+//#	Each entry holds:
+//#		uiSequence	incremented with each entry
+//#		uiState		state of the outputs
+//#		uiCheck		uiSequence ^ uiState ^ JOURNAL_CHECK
+//#	The entry with the highest sequence number and a correct check
+//#	word is the last one. An entry that was not written completely
+//#	(power off while writing) has a wrong check word and is ignored.
+//#
+//#	The entries are written by the EEPROM ready interrupt, see
+//#	lncv_storage.cpp. The LNCVs have priority.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <avr/io.h>
+#include <stdint.h>
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+//----------------------------------------------------------------------
+//	EEPROM area of the journal
+//	(the LNCVs use the EEPROM from address 0 on)
+//
+#define JOURNAL_START			0x0100
+#define JOURNAL_END				(E2END + 1)
+#define JOURNAL_ENTRY_SIZE		6
+#define JOURNAL_SLOTS			((JOURNAL_END - JOURNAL_START) / JOURNAL_ENTRY_SIZE)
+
+#define JOURNAL_CHECK			0xA5A5
+
+
+//==========================================================================
+//
+//		C L A S S   D E F I N I T I O N S
+//
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////
+//	CLASS:	StateJournalClass
+//
+class StateJournalClass
+{
+	public:
+		StateJournalClass();
+
+		bool	Restore( uint16_t *puiState );
+		void	Store( uint16_t uiState );
+		bool	WriteNextByte( void );
+		bool	IsPending( void );
+		void	Flush( void );
+
+	private:
+		//----------------------------------------------------------
+		//	m_uiWanted		state to be stored (set by Store())
+		//	m_uiStored		state of the last entry
+		//	m_uiSequence	sequence number of the last entry
+		//	m_usSlot		next entry to be written
+		//	m_arusEntry		entry that is written by the interrupt
+		//	m_usEntryByte	next byte of the entry to be written
+		//					(JOURNAL_ENTRY_SIZE: nothing to write)
+		//
+		volatile uint16_t	m_uiWanted;
+		uint16_t			m_uiStored;
+		uint16_t			m_uiSequence;
+		uint8_t				m_usSlot;
+		uint8_t				m_arusEntry[ JOURNAL_ENTRY_SIZE ];
+		volatile uint8_t	m_usEntryByte;
+};
+
+
+//==========================================================================
+//
+//		E X T E R N   G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+extern StateJournalClass	g_clStateJournal;
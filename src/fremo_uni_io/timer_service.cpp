@@ -0,0 +1,243 @@
+//##########################################################################
+//#
+//#		TimerServiceClass
+//#
+//#	This class handles the millisecond timers, e.g. the off delay
+//#	timers of the inputs.
+//#	Each timer is identified by its number (0 .. TIMER_SERVICE_COUNT-1).
+//#	The running timers are linked in the order of their deadlines:
+//#		m_usFirst		number of the timer that expires next
+//#		m_arusNext[]	number of the timer that expires after this one
+//#	TIMER_NONE marks the end of the list.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	3		vom: 17.10.2026
+//#
+//#	Bugfix:
+//#		-	StartAt() with a start time more than 2^31 ms ago gave
+//#			a deadline that looked like a future one, the timer
+//#			did not expire for up to 24.8 days. The start time is
+//#			now at most 'uiDelay' + 1 ms in the past.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new function StartAt()
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <Arduino.h>
+
+#include "timer_service.h"
+
+
+//==========================================================================
+//
+//		G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+TimerServiceClass	g_clTimerService	= TimerServiceClass();
+
+
+//==========================================================================
+//
+//		C L A S S   F U N C T I O N S
+//
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////
+//	CLASS: TimerServiceClass
+//
+
+//**********************************************************************
+//	Constructor
+//----------------------------------------------------------------------
+//
+TimerServiceClass::TimerServiceClass()
+{
+	Init();
+}
+
+
+//**********************************************************************
+//	Init
+//----------------------------------------------------------------------
+//	stops all timers
+//
+void TimerServiceClass::Init( void )
+{
+	m_usFirst	= TIMER_NONE;
+	m_uiRunning	= 0x0000;
+
+	for( uint8_t idx = 0 ; idx < TIMER_SERVICE_COUNT ; idx++ )
+	{
+		m_arulDeadline[ idx ]	= 0L;
+		m_arusNext[ idx ]		= TIMER_NONE;
+	}
+}
+
+
+//**********************************************************************
+//	Start
+//----------------------------------------------------------------------
+//	The timer will expire 'uiDelay' ms from now.
+//	If the timer is already running, it will be started again.
+//
+void TimerServiceClass::Start( uint8_t usTimer, uint16_t uiDelay )
+{
+	StartAt( usTimer, millis(), uiDelay );
+}
+
+
+//**********************************************************************
+//	StartAt
+//----------------------------------------------------------------------
+//	The timer will expire 'uiDelay' ms after 'ulStart' (e.g. the time
+//	of an input edge). If that time has already passed, the timer
+//	will be delivered by the next call of GetExpired().
+//	'ulStart' may be arbitrarily old, it is moved forward to at
+//	most 'uiDelay' + 1 ms ago, so the deadline never wraps around.
+//	If the timer is already running, it will be started again.
+//
+void TimerServiceClass::StartAt( uint8_t usTimer, uint32_t ulStart, uint16_t uiDelay )
+{
+	uint32_t	ulNow	= millis();
+	uint32_t	ulDeadline;
+	uint8_t		usPrev	= TIMER_NONE;
+	uint8_t		usNext	= m_usFirst;
+
+	if( TIMER_SERVICE_COUNT <= usTimer )
+	{
+		return;
+	}
+
+	Remove( usTimer );
+
+	//--------------------------------------------------------------
+	//	a deadline that has passed is kept 1 ms in the past,
+	//	IsTimeOver() sees it at once
+	//
+	if( (ulNow - ulStart) > ((uint32_t)uiDelay + 1) )
+	{
+		ulStart = ulNow - uiDelay - 1;
+	}
+
+	ulDeadline = ulStart + uiDelay;
+
+	//--------------------------------------------------------------
+	//	find the position in the list,
+	//	timers with the same deadline keep the order of starting
+	//
+	while(		(TIMER_NONE != usNext)
+			&&	(0 <= (int32_t)(ulDeadline - m_arulDeadline[ usNext ]))	)
+	{
+		usPrev = usNext;
+		usNext = m_arusNext[ usNext ];
+	}
+
+	m_arulDeadline[ usTimer ]	= ulDeadline;
+	m_arusNext[ usTimer ]		= usNext;
+
+	if( TIMER_NONE == usPrev )
+	{
+		m_usFirst = usTimer;
+	}
+	else
+	{
+		m_arusNext[ usPrev ] = usTimer;
+	}
+
+	m_uiRunning |= (((uint16_t)1) << usTimer);
+}
+
+
+//**********************************************************************
+//	Stop
+//----------------------------------------------------------------------
+//
+void TimerServiceClass::Stop( uint8_t usTimer )
+{
+	if( TIMER_SERVICE_COUNT > usTimer )
+	{
+		Remove( usTimer );
+	}
+}
+
+
+//**********************************************************************
+//	GetExpired
+//----------------------------------------------------------------------
+//	If the first timer of the list has expired, it will be stopped
+//	and its number returned. Otherwise TIMER_NONE will be returned.
+//	Call the function until it returns TIMER_NONE to get all
+//	expired timers.
+//
+uint8_t TimerServiceClass::GetExpired( uint32_t ulNow )
+{
+	uint8_t	usTimer = m_usFirst;
+
+	if( (TIMER_NONE == usTimer) || !IsTimeOver( ulNow, m_arulDeadline[ usTimer ] ) )
+	{
+		return( TIMER_NONE );
+	}
+
+	m_usFirst				= m_arusNext[ usTimer ];
+	m_arusNext[ usTimer ]	= TIMER_NONE;
+	m_uiRunning			   &= ~(((uint16_t)1) << usTimer);
+
+	return( usTimer );
+}
+
+
+//**********************************************************************
+//	Remove
+//----------------------------------------------------------------------
+//	takes the timer out of the list (if it is running)
+//
+void TimerServiceClass::Remove( uint8_t usTimer )
+{
+	uint8_t	usPrev;
+
+	if( !IsRunning( usTimer ) )
+	{
+		return;
+	}
+
+	if( m_usFirst == usTimer )
+	{
+		m_usFirst = m_arusNext[ usTimer ];
+	}
+	else
+	{
+		usPrev = m_usFirst;
+
+		while( m_arusNext[ usPrev ] != usTimer )
+		{
+			usPrev = m_arusNext[ usPrev ];
+		}
+
+		m_arusNext[ usPrev ] = m_arusNext[ usTimer ];
+	}
+
+	m_arusNext[ usTimer ]	= TIMER_NONE;
+	m_uiRunning			   &= ~(((uint16_t)1) << usTimer);
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		TimerServiceClass
+//#
+//#	This class handles up to TIMER_SERVICE_COUNT millisecond timers.
+//#	The running timers are kept in a list sorted by their deadline,
+//#	so checking for expired timers only needs to look at the first
+//#	entry of the list.
+//#	All time comparisons are done by subtraction, so the timers will
+//#	work across the overflow of millis() after 49.7 days.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	2		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	new function StartAt()
+//#			the delay is counted from a given start time
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include <stdint.h>
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+#define TIMER_SERVICE_COUNT		16
+#define TIMER_NONE				0xFF
+
+
+//==========================================================================
+//
+//		I N L I N E   F U N C T I O N S
+//
+//==========================================================================
+
+//**********************************************************************
+//	IsTimeOver
+//----------------------------------------------------------------------
+//	returns true if 'ulNow' is after 'ulDeadline'
+//	The difference is interpreted as signed value, so the result is
+//	correct as long as both times are less than 24.8 days apart.
+//
+static inline bool IsTimeOver( uint32_t ulNow, uint32_t ulDeadline )
+{
+	return( 0 < (int32_t)(ulNow - ulDeadline) );
+}
+
+
+//==========================================================================
+//
+//		C L A S S   D E F I N I T I O N S
+//
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////
+//	CLASS:	TimerServiceClass
+//
+class TimerServiceClass
+{
+	public:
+		TimerServiceClass();
+
+		void	Init( void );
+
+		void	Start(   uint8_t usTimer, uint16_t uiDelay );
+		void	StartAt( uint8_t usTimer, uint32_t ulStart, uint16_t uiDelay );
+		void	Stop(  uint8_t usTimer );
+		uint8_t	GetExpired( uint32_t ulNow );
+
+		inline bool IsRunning( uint8_t usTimer )
+		{
+			return( 0 != (m_uiRunning & (((uint16_t)1) << usTimer)) );
+		};
+
+	private:
+		uint32_t	m_arulDeadline[ TIMER_SERVICE_COUNT ];
+		uint8_t		m_arusNext[ TIMER_SERVICE_COUNT ];
+		uint8_t		m_usFirst;
+		uint16_t	m_uiRunning;
+
+		void	Remove( uint8_t usTimer );
+};
+
+
+//==========================================================================
+//
+//		E X T E R N   G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+extern TimerServiceClass	g_clTimerService;
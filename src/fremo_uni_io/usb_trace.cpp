@@ -0,0 +1,234 @@
+//##########################################################################
+//#
+//#		UsbTraceClass
+//#
+//#	This class sends the trace records over the native USB serial
+//#	interface (see usb_trace.h).
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include "compile_options.h"
+
+
+#ifdef USB_TRACE
+//**************************************************************************
+//**************************************************************************
+
+
+#include <Arduino.h>
+
+#include "usb_trace.h"
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+static_assert(	0 == (TRACE_RING_SIZE & (TRACE_RING_SIZE - 1)),
+				"TRACE_RING_SIZE must be a power of 2"			);
+
+
+//==========================================================================
+//
+//		G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+UsbTraceClass	g_clUsbTrace	= UsbTraceClass();
+
+
+//==========================================================================
+//
+//		C L A S S   F U N C T I O N S
+//
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////
+//	CLASS: UsbTraceClass
+//
+
+//**********************************************************************
+//	Constructor
+//----------------------------------------------------------------------
+//
+UsbTraceClass::UsbTraceClass()
+{
+	m_usRead		= 0;
+	m_usCount		= 0;
+	m_uiDropped		= 0;
+	m_bDropPending	= false;
+	m_uiLoopStart	= 0;
+	m_uiLoopMax		= 0;
+	m_uiLoops		= 0;
+}
+
+
+//**********************************************************************
+//	Init
+//----------------------------------------------------------------------
+//	'Serial.begin()' does not wait for the host, the start record
+//	stays in the ring until the host opens the interface
+//
+void UsbTraceClass::Init( uint16_t uiVersion )
+{
+	Serial.begin( TRACE_BAUDRATE );
+
+	m_uiLoopStart = (uint16_t)millis();
+
+	Add( TRACE_TYPE_START, uiVersion, 0 );
+}
+
+
+//**********************************************************************
+//	Add
+//----------------------------------------------------------------------
+//	puts a record into the ring. If the ring is full, the record is
+//	dropped. The number of dropped records is put into the ring in
+//	front of the next record that fits.
+//
+void UsbTraceClass::Add( uint8_t usType, uint16_t uiValueA, uint16_t uiValueB )
+{
+	if( m_bDropPending && ((TRACE_RING_SIZE - 1) > m_usCount) )
+	{
+		Put( TRACE_TYPE_DROPPED, m_uiDropped, 0 );
+
+		m_bDropPending = false;
+	}
+
+	if( m_bDropPending || (TRACE_RING_SIZE <= m_usCount) )
+	{
+		m_uiDropped++;
+		m_bDropPending = true;
+
+		return;
+	}
+
+	Put( usType, uiValueA, uiValueB );
+}
+
+
+//**********************************************************************
+//	LoopTime
+//----------------------------------------------------------------------
+//	is called at the end of each loop with the time the loop took.
+//	Every TRACE_LOOP_PERIOD ms the max loop time and the number of
+//	loops of the period are traced.
+//
+void UsbTraceClass::LoopTime( uint32_t ulMicros )
+{
+	uint16_t	uiNow	= (uint16_t)millis();
+
+	if( ulMicros > m_uiLoopMax )
+	{
+		m_uiLoopMax = (0xFFFF < ulMicros) ? 0xFFFF : (uint16_t)ulMicros;
+	}
+
+	if( 0xFFFF > m_uiLoops )
+	{
+		m_uiLoops++;
+	}
+
+	if( TRACE_LOOP_PERIOD <= (uint16_t)(uiNow - m_uiLoopStart) )
+	{
+		Add( TRACE_TYPE_LOOP, m_uiLoopMax, m_uiLoops );
+
+		m_uiLoopStart	= uiNow;
+		m_uiLoopMax		= 0;
+		m_uiLoops		= 0;
+	}
+}
+
+
+//**********************************************************************
+//	Flush
+//----------------------------------------------------------------------
+//	hands over the records of the ring that fit into the USB
+//	endpoint. The records are only sent while the host has opened
+//	the interface (DTR), otherwise they stay in the ring.
+//	'Serial.write()' waits only if there is no space in the
+//	endpoint, so it is never called with more than
+//	'availableForWrite()' bytes.
+//
+void UsbTraceClass::Flush( void )
+{
+	int		iSpace;
+	uint8_t	usRecords;
+
+	if( (0 == m_usCount) || !Serial.dtr() )
+	{
+		return;
+	}
+
+	iSpace		= Serial.availableForWrite();
+	usRecords	= TRACE_RING_SIZE - m_usRead;		//	up to the end of the ring
+
+	if( usRecords > m_usCount )
+	{
+		usRecords = m_usCount;
+	}
+
+	if( usRecords > (iSpace / TRACE_RECORD_SIZE) )
+	{
+		usRecords = iSpace / TRACE_RECORD_SIZE;
+	}
+
+	if( 0 < usRecords )
+	{
+		Serial.write( m_arRing[ m_usRead ], usRecords * TRACE_RECORD_SIZE );
+
+		m_usRead	 = (m_usRead + usRecords) & (TRACE_RING_SIZE - 1);
+		m_usCount	-= usRecords;
+	}
+}
+
+
+//**********************************************************************
+//	Put
+//----------------------------------------------------------------------
+//	the caller has checked that there is space in the ring
+//
+void UsbTraceClass::Put( uint8_t usType, uint16_t uiValueA, uint16_t uiValueB )
+{
+	uint8_t *	pRecord	= m_arRing[ (m_usRead + m_usCount) & (TRACE_RING_SIZE - 1) ];
+	uint16_t	uiTime	= (uint16_t)millis();
+	uint8_t		usCheck	= 0;
+
+	pRecord[ 0 ] = TRACE_SYNC | (usType & TRACE_TYPE_MASK);
+	pRecord[ 1 ] = (uint8_t)uiTime;
+	pRecord[ 2 ] = (uint8_t)(uiTime >> 8);
+	pRecord[ 3 ] = (uint8_t)uiValueA;
+	pRecord[ 4 ] = (uint8_t)(uiValueA >> 8);
+	pRecord[ 5 ] = (uint8_t)uiValueB;
+	pRecord[ 6 ] = (uint8_t)(uiValueB >> 8);
+
+	for( uint8_t idx = 0 ; idx < (TRACE_RECORD_SIZE - 1) ; idx++ )
+	{
+		usCheck ^= pRecord[ idx ];
+	}
+
+	pRecord[ TRACE_RECORD_SIZE - 1 ] = usCheck;
+
+	m_usCount++;
+}
+
+
+//**************************************************************************
+//**************************************************************************
+#endif	//	USB_TRACE
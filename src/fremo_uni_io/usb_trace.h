@@ -0,0 +1,186 @@
+#pragma once
+
+//##########################################################################
+//#
+//#		UsbTraceClass
+//#
+//#	This class sends a stream of binary trace records over the
+//#	native USB serial interface (CDC) of the ATmega32U4:
+//#		TRACE_TYPE_INPUT		inputs have changed
+//#		TRACE_TYPE_LN_RX		switch/sensor message received
+//#		TRACE_TYPE_LN_TX		switch/sensor message sent
+//#		TRACE_TYPE_LNCV_xxx		LNCV programming
+//#		TRACE_TYPE_LOOP			loop time, every TRACE_LOOP_PERIOD ms
+//#		TRACE_TYPE_DROPPED		records were lost
+//#		TRACE_TYPE_START		the board has started
+//#
+//#	The records are collected in a ring in RAM. 'Flush()' is called
+//#	in each pass of 'loop()' and hands over only as many records as
+//#	the USB endpoint takes without waiting. If nobody reads the
+//#	interface, the ring runs full and new records are dropped and
+//#	counted. So the trace never blocks the board.
+//#
+//#	Each record has TRACE_RECORD_SIZE bytes:
+//#		0		TRACE_SYNC | type
+//#		1, 2	time in ms (low byte first, wraps after 65.5 s)
+//#		3, 4	value A (low byte first)
+//#		5, 6	value B (low byte first)
+//#		7		XOR of the bytes 0 .. 6
+//#	The host decoder is host/trace/trace_decode.cpp.
+//#
+//#	Only compiled with the compile option USB_TRACE, otherwise the
+//#	TRACE_xxx() macros are empty. The record format is always
+//#	defined, it is used by the host decoder too.
+//#
+//#-------------------------------------------------------------------------
+//#
+//#	File version:	1		vom: 17.10.2026
+//#
+//#	Implementation:
+//#		-	first version
+//#
+//##########################################################################
+
+
+//==========================================================================
+//
+//		I N C L U D E S
+//
+//==========================================================================
+
+#include "compile_options.h"
+
+#include <stdint.h>
+
+
+//==========================================================================
+//
+//		D E F I N I T I O N S
+//
+//==========================================================================
+
+#define TRACE_RECORD_SIZE		8
+#define TRACE_SYNC				0xA0
+#define TRACE_SYNC_MASK			0xF0
+#define TRACE_TYPE_MASK			0x0F
+
+//----------------------------------------------------------------------
+//	record types			value A				value B
+//
+#define TRACE_TYPE_INPUT		1	//	changed inputs		new state
+#define TRACE_TYPE_LN_RX		2	//	address				TRACE_FLAG_xxx
+#define TRACE_TYPE_LN_TX		3	//	address				TRACE_FLAG_xxx
+#define TRACE_TYPE_LNCV_READ	4	//	LNCV				value
+#define TRACE_TYPE_LNCV_WRITE	5	//	LNCV				value
+#define TRACE_TYPE_LNCV_START	6	//	article number		module address
+#define TRACE_TYPE_LNCV_STOP	7	//	article number		module address
+#define TRACE_TYPE_LOOP			8	//	max loop time us	number of loops
+#define TRACE_TYPE_DROPPED		9	//	records dropped		-
+#define TRACE_TYPE_START		10	//	version number		-
+
+//----------------------------------------------------------------------
+//	flags of the Loconet records
+//
+#define TRACE_FLAG_DIR			0x01
+#define TRACE_FLAG_SENSOR		0x02
+#define TRACE_FLAG_MATCHED		0x04	//	RX: for our outputs
+#define TRACE_FLAG_ECHO			0x08	//	RX: echo of our message
+#define TRACE_FLAG_FAILED		0x80	//	TX: not sent
+
+#define TRACE_LN_FLAGS( isSensor, dir )	(	((isSensor) ? TRACE_FLAG_SENSOR : 0)	\
+										|	((dir) ? TRACE_FLAG_DIR : 0)			)
+
+#define TRACE_LOOP_PERIOD		1000
+
+
+#ifdef USB_TRACE
+//**************************************************************************
+//**************************************************************************
+
+
+//----------------------------------------------------------------------
+//	TRACE_RING_SIZE must be a power of 2
+//
+#define TRACE_RING_SIZE			16
+#define TRACE_BAUDRATE			115200	//	ignored by the USB CDC
+
+#define TRACE_INPUT( changed, state )		g_clUsbTrace.Input( changed, state )
+#define TRACE_LN_RX( adr, flags )			g_clUsbTrace.Add( TRACE_TYPE_LN_RX, adr, flags )
+#define TRACE_LN_TX( adr, flags )			g_clUsbTrace.Add( TRACE_TYPE_LN_TX, adr, flags )
+#define TRACE_LNCV( type, a, b )			g_clUsbTrace.Add( type, a, b )
+#define TRACE_LOOP( micros )				g_clUsbTrace.LoopTime( micros )
+#define TRACE_FLUSH()						g_clUsbTrace.Flush()
+
+
+//==========================================================================
+//
+//		C L A S S   D E F I N I T I O N S
+//
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////
+//	CLASS:	UsbTraceClass
+//
+class UsbTraceClass
+{
+	public:
+		UsbTraceClass();
+
+		void Init( uint16_t uiVersion );
+		void Add( uint8_t usType, uint16_t uiValueA, uint16_t uiValueB );
+		void LoopTime( uint32_t ulMicros );
+		void Flush( void );
+
+		inline void Input( uint16_t uiChanged, uint16_t uiState )
+		{
+			if( uiChanged )
+			{
+				Add( TRACE_TYPE_INPUT, uiChanged, uiState );
+			}
+		};
+
+	private:
+		//----------------------------------------------------------
+		//	m_usRead		next record to send
+		//	m_usCount		records in the ring
+		//	m_uiDropped		records lost since the start
+		//	m_bDropPending	the loss is not yet reported
+		//	m_uiLoopStart	start of the loop time period
+		//	m_uiLoopMax		max loop time in this period (us)
+		//	m_uiLoops		loops in this period
+		//
+		uint8_t		m_arRing[ TRACE_RING_SIZE ][ TRACE_RECORD_SIZE ];
+		uint8_t		m_usRead;
+		uint8_t		m_usCount;
+		uint16_t	m_uiDropped;
+		bool		m_bDropPending;
+		uint16_t	m_uiLoopStart;
+		uint16_t	m_uiLoopMax;
+		uint16_t	m_uiLoops;
+
+		void Put( uint8_t usType, uint16_t uiValueA, uint16_t uiValueB );
+};
+
+
+//==========================================================================
+//
+//		E X T E R N   G L O B A L   V A R I A B L E S
+//
+//==========================================================================
+
+extern UsbTraceClass	g_clUsbTrace;
+
+
+//**************************************************************************
+//**************************************************************************
+#else	//	USB_TRACE
+
+#define TRACE_INPUT( changed, state )
+#define TRACE_LN_RX( adr, flags )
+#define TRACE_LN_TX( adr, flags )
+#define TRACE_LNCV( type, a, b )
+#define TRACE_LOOP( micros )
+#define TRACE_FLUSH()
+
+#endif	//	USB_TRACE